@@ -21,6 +21,12 @@ if (NOT VAES_SUPPORTED)
     set(WITH_VAES OFF)
 endif()
 
+if (CMAKE_CXX_COMPILER_ID MATCHES MSVC)
+    set(AVX512F_SUPPORTED ON)
+else()
+    CHECK_CXX_COMPILER_FLAG("-mavx512f" AVX512F_SUPPORTED)
+endif()
+
 # Detect RISC-V architecture early (before it's used below)
 if (CMAKE_SYSTEM_PROCESSOR MATCHES "^(riscv64|riscv|rv64)$")
     set(RISCV_TARGET 64)
@@ -133,4 +139,8 @@ endif()
 
 if (WITH_AVX2)
     add_definitions(-DXMRIG_FEATURE_AVX2)
+
+    if (AVX512F_SUPPORTED)
+        add_definitions(-DXMRIG_FEATURE_AVX512F)
+    endif()
 endif()
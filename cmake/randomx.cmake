@@ -46,6 +46,7 @@ if (WITH_RANDOMX)
         src/crypto/randomx/vm_compiled.cpp
         src/crypto/randomx/vm_interpreted_light.cpp
         src/crypto/randomx/vm_interpreted.cpp
+        src/crypto/randomx/vm_template.cpp
         src/crypto/rx/Rx.cpp
         src/crypto/rx/RxAlgo.cpp
         src/crypto/rx/RxBasicStorage.cpp
@@ -105,10 +106,22 @@ if (WITH_RANDOMX)
     endif()
 
     if (WITH_AVX2)
-        list(APPEND SOURCES_CRYPTO src/crypto/randomx/blake2/avx2/blake2b_avx2.c)
+        list(APPEND SOURCES_CRYPTO
+             src/crypto/randomx/blake2/avx2/blake2b_avx2.c
+             src/crypto/randomx/blake2/blake2b_multi_avx2.c
+            )
 
         if (CMAKE_C_COMPILER_ID MATCHES GNU OR CMAKE_C_COMPILER_ID MATCHES Clang)
             set_source_files_properties(src/crypto/randomx/blake2/avx2/blake2b_avx2.c PROPERTIES COMPILE_FLAGS "-Ofast -mavx2")
+            set_source_files_properties(src/crypto/randomx/blake2/blake2b_multi_avx2.c PROPERTIES COMPILE_FLAGS "-Ofast -mavx2")
+        endif()
+
+        if (AVX512F_SUPPORTED)
+            list(APPEND SOURCES_CRYPTO src/crypto/randomx/blake2/blake2b_multi_avx512.c)
+
+            if (CMAKE_C_COMPILER_ID MATCHES GNU OR CMAKE_C_COMPILER_ID MATCHES Clang)
+                set_source_files_properties(src/crypto/randomx/blake2/blake2b_multi_avx512.c PROPERTIES COMPILE_FLAGS "-Ofast -mavx512f")
+            endif()
         endif()
     endif()
 
@@ -324,12 +324,24 @@ void xmrig_ar2_fill_segment_avx2(const argon2_instance_t *instance, argon2_posit
 }
 
 
+#define ARGON2_MULTI_VEC __m256i
+#define ARGON2_MULTI_VECS_IN_BLOCK ARGON2_HWORDS_IN_BLOCK
+
+#include "argon2-template-multi.h"
+
+void xmrig_ar2_fill_segment_multi_avx2(const argon2_instance_t *const *instances, size_t count, argon2_position_t position)
+{
+    fill_segment_multi(instances, count, position);
+}
+
+
 extern int cpu_flags_has_avx2(void);
 int xmrig_ar2_check_avx2(void) { return cpu_flags_has_avx2(); }
 
 #else
 
 void xmrig_ar2_fill_segment_avx2(const argon2_instance_t *instance, argon2_position_t position) {}
+void xmrig_ar2_fill_segment_multi_avx2(const argon2_instance_t *const *instances, size_t count, argon2_position_t position) {}
 int xmrig_ar2_check_avx2(void) { return 0; }
 
 #endif
@@ -4,6 +4,7 @@
 #include "core.h"
 
 void xmrig_ar2_fill_segment_avx2(const argon2_instance_t *instance, argon2_position_t position);
+void xmrig_ar2_fill_segment_multi_avx2(const argon2_instance_t *const *instances, size_t count, argon2_position_t position);
 int xmrig_ar2_check_avx2(void);
 
 #endif // ARGON2_AVX2_H
@@ -0,0 +1,100 @@
+/*
+ * Interleaved fill_segment for several independent single lane instances
+ * with the same parameters: block i of every instance is computed before
+ * block i + 1 of any of them, so the reference block loads of one instance
+ * overlap with the compression of the others.
+ *
+ * The including file provides fill_block(), next_addresses(),
+ * ARGON2_MULTI_VEC (register type) and ARGON2_MULTI_VECS_IN_BLOCK.
+ */
+
+static void fill_segment_multi(const argon2_instance_t *const *instances, size_t count, argon2_position_t position)
+{
+    const argon2_instance_t *instance = instances[0];
+    block *ref_blocks[ARGON2_MAX_MULTI_HASHES];
+    block address_block, input_block;
+    uint64_t pseudo_rand;
+    uint32_t prev_offset, curr_offset;
+    uint32_t starting_index, i;
+    size_t k, line;
+    ARGON2_MULTI_VEC state[ARGON2_MAX_MULTI_HASHES][ARGON2_MULTI_VECS_IN_BLOCK];
+    int data_independent_addressing, with_xor;
+
+    data_independent_addressing = (instance->type == Argon2_i) ||
+            (instance->type == Argon2_id && (position.pass == 0) &&
+             (position.slice < ARGON2_SYNC_POINTS / 2));
+
+    /* addresses don't depend on the data, one address block serves all instances */
+    if (data_independent_addressing) {
+        init_block_value(&input_block, 0);
+
+        input_block.v[0] = position.pass;
+        input_block.v[1] = position.lane;
+        input_block.v[2] = position.slice;
+        input_block.v[3] = instance->memory_blocks;
+        input_block.v[4] = instance->passes;
+        input_block.v[5] = instance->type;
+    }
+
+    starting_index = 0;
+
+    if ((0 == position.pass) && (0 == position.slice)) {
+        starting_index = 2; /* we have already generated the first two blocks */
+
+        /* Don't forget to generate the first block of addresses: */
+        if (data_independent_addressing) {
+            next_addresses(&address_block, &input_block);
+        }
+    }
+
+    /* Offset of the current block */
+    curr_offset = position.slice * instance->segment_length + starting_index;
+
+    if (0 == curr_offset % instance->lane_length) {
+        /* Last block in this lane */
+        prev_offset = curr_offset + instance->lane_length - 1;
+    } else {
+        /* Previous block */
+        prev_offset = curr_offset - 1;
+    }
+
+    for (k = 0; k < count; ++k) {
+        memcpy(state[k], ((instances[k]->memory + prev_offset)->v), ARGON2_BLOCK_SIZE);
+    }
+
+    /* version 1.2.1 and earlier: overwrite, not XOR */
+    with_xor = !(0 == position.pass || ARGON2_VERSION_10 == instance->version);
+
+    for (i = starting_index; i < instance->segment_length;
+         ++i, ++curr_offset, ++prev_offset) {
+        /*1.1 Rotating prev_offset if needed */
+        if (curr_offset % instance->lane_length == 1) {
+            prev_offset = curr_offset - 1;
+        }
+
+        if (data_independent_addressing && i % ARGON2_ADDRESSES_IN_BLOCK == 0) {
+            next_addresses(&address_block, &input_block);
+        }
+
+        position.index = i;
+
+        /* Resolve and prefetch all reference blocks before compressing any of them */
+        for (k = 0; k < count; ++k) {
+            if (data_independent_addressing) {
+                pseudo_rand = address_block.v[i % ARGON2_ADDRESSES_IN_BLOCK];
+            } else {
+                pseudo_rand = instances[k]->memory[prev_offset].v[0];
+            }
+
+            ref_blocks[k] = instances[k]->memory + xmrig_ar2_index_alpha(instance, &position, pseudo_rand & 0xFFFFFFFF, 1);
+
+            for (line = 0; line < ARGON2_BLOCK_SIZE; line += 64) {
+                _mm_prefetch((const char *)ref_blocks[k] + line, _MM_HINT_T0);
+            }
+        }
+
+        for (k = 0; k < count; ++k) {
+            fill_block(state[k], ref_blocks[k], instances[k]->memory + curr_offset, with_xor);
+        }
+    }
+}
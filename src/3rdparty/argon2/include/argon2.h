@@ -66,6 +66,9 @@ extern "C" {
 #define ARGON2_MIN_AD_LENGTH UINT32_C(0)
 #define ARGON2_MAX_AD_LENGTH UINT32_C(0xFFFFFFFF)
 
+/* Maximum number of hashes computed at once by argon2id_hash_raw_ex_multi */
+#define ARGON2_MAX_MULTI_HASHES 4
+
 /* Minimum and maximum salt length in bytes */
 #define ARGON2_MIN_SALT_LENGTH UINT32_C(8)
 #define ARGON2_MAX_SALT_LENGTH UINT32_C(0xFFFFFFFF)
@@ -316,6 +319,25 @@ ARGON2_PUBLIC int argon2id_hash_raw_ex(const uint32_t t_cost,
                                        const size_t hashlen,
                                        void *memory);
 
+/**
+ * Computes @count independent single lane Argon2id hashes with the same
+ * parameters at once, interleaving their memory passes when the selected
+ * implementation supports it.
+ * @param pwd, salt, hash, memory Arrays of @count pointers, one per hash
+ * @param memory Preallocated blocks for each hash, at least m_cost KiB each
+ * @param count Number of hashes, 1 to ARGON2_MAX_MULTI_HASHES
+ */
+ARGON2_PUBLIC int argon2id_hash_raw_ex_multi(const uint32_t t_cost,
+                                             const uint32_t m_cost,
+                                             const void *const *pwd,
+                                             const size_t pwdlen,
+                                             const void *const *salt,
+                                             const size_t saltlen,
+                                             void *const *hash,
+                                             const size_t hashlen,
+                                             void *const *memory,
+                                             const size_t count);
+
 /* generic function underlying the above ones */
 ARGON2_PUBLIC int argon2_hash(const uint32_t t_cost, const uint32_t m_cost,
                               const uint32_t parallelism, const void *pwd,
@@ -442,6 +464,22 @@ ARGON2_PUBLIC void argon2_select_impl();
 ARGON2_PUBLIC const char *argon2_get_impl_name();
 ARGON2_PUBLIC int argon2_select_impl_by_name(const char *name);
 
+/**
+ * Enumerates the built-in implementations.
+ * @param index Implementation index, 0 to argon2_get_impl_count() - 1
+ * @return The implementation name or NULL if the CPU doesn't support it
+ */
+ARGON2_PUBLIC size_t argon2_get_impl_count();
+ARGON2_PUBLIC const char *argon2_get_available_impl_name(size_t index);
+
+/**
+ * Fills m_cost blocks of memory in t_cost passes (one lane, Argon2id) with the
+ * implementation at index, without selecting it. Used to benchmark the
+ * implementations while other threads keep hashing with the selected one.
+ * @return 0 if the implementation is not available on this CPU
+ */
+ARGON2_PUBLIC int argon2_fill_with_impl(size_t index, void *memory, uint32_t m_cost, uint32_t t_cost);
+
 /* signals support for passing preallocated memory: */
 #define ARGON2_PREALLOCATED_MEMORY
 
@@ -287,6 +287,85 @@ int argon2id_hash_raw_ex(const uint32_t t_cost, const uint32_t m_cost,
     return argon2_ctx_mem(&context, Argon2_id, memory, m_cost * 1024);
 }
 
+int argon2id_hash_raw_ex_multi(const uint32_t t_cost, const uint32_t m_cost,
+                               const void *const *pwd, const size_t pwdlen,
+                               const void *const *salt, const size_t saltlen,
+                               void *const *hash, const size_t hashlen,
+                               void *const *memory, const size_t count) {
+    argon2_context context[ARGON2_MAX_MULTI_HASHES];
+    argon2_instance_t instance[ARGON2_MAX_MULTI_HASHES];
+    argon2_instance_t *instances[ARGON2_MAX_MULTI_HASHES];
+    uint32_t memory_blocks, segment_length;
+    size_t i;
+    int result;
+
+    if (count == 0 || count > ARGON2_MAX_MULTI_HASHES) {
+        return ARGON2_INCORRECT_PARAMETER;
+    }
+
+    argon2_compute_memory_blocks(&memory_blocks, &segment_length, m_cost, 1);
+
+    for (i = 0; i < count; ++i) {
+        context[i].out = (uint8_t *)hash[i];
+        context[i].outlen = (uint32_t)hashlen;
+        context[i].pwd = CONST_CAST(uint8_t *)pwd[i];
+        context[i].pwdlen = (uint32_t)pwdlen;
+        context[i].salt = CONST_CAST(uint8_t *)salt[i];
+        context[i].saltlen = (uint32_t)saltlen;
+        context[i].secret = NULL;
+        context[i].secretlen = 0;
+        context[i].ad = NULL;
+        context[i].adlen = 0;
+        context[i].t_cost = t_cost;
+        context[i].m_cost = m_cost;
+        context[i].lanes = 1;
+        context[i].threads = 1;
+        context[i].allocate_cbk = NULL;
+        context[i].free_cbk = NULL;
+        context[i].flags = ARGON2_DEFAULT_FLAGS;
+        context[i].version = ARGON2_VERSION_NUMBER;
+
+        result = xmrig_ar2_validate_inputs(&context[i]);
+        if (ARGON2_OK != result) {
+            return result;
+        }
+
+        if (memory[i] == NULL) {
+            return ARGON2_MEMORY_ALLOCATION_ERROR;
+        }
+
+        instance[i].version = context[i].version;
+        instance[i].memory = (block *)memory[i];
+        instance[i].passes = t_cost;
+        instance[i].memory_blocks = memory_blocks;
+        instance[i].segment_length = segment_length;
+        instance[i].lane_length = segment_length * ARGON2_SYNC_POINTS;
+        instance[i].lanes = 1;
+        instance[i].threads = 1;
+        instance[i].type = Argon2_id;
+        instance[i].print_internals = 0;
+        instance[i].keep_memory = 1;
+
+        result = xmrig_ar2_initialize(&instance[i], &context[i]);
+        if (ARGON2_OK != result) {
+            return result;
+        }
+
+        instances[i] = &instance[i];
+    }
+
+    result = xmrig_ar2_fill_memory_blocks_multi(instances, count);
+    if (ARGON2_OK != result) {
+        return result;
+    }
+
+    for (i = 0; i < count; ++i) {
+        xmrig_ar2_finalize(&context[i], &instance[i]);
+    }
+
+    return ARGON2_OK;
+}
+
 static int argon2_compare(const uint8_t *b1, const uint8_t *b2, size_t len) {
     size_t i;
     uint8_t d = 0U;
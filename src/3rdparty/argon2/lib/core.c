@@ -271,6 +271,22 @@ int xmrig_ar2_fill_memory_blocks(argon2_instance_t *instance) {
     return fill_memory_blocks_st(instance);
 }
 
+int xmrig_ar2_fill_memory_blocks_multi(argon2_instance_t *const *instances, size_t count) {
+    uint32_t r, s;
+
+    if (instances == NULL || count == 0 || count > ARGON2_MAX_MULTI_HASHES) {
+        return ARGON2_INCORRECT_PARAMETER;
+    }
+
+    for (r = 0; r < instances[0]->passes; ++r) {
+        for (s = 0; s < ARGON2_SYNC_POINTS; ++s) {
+            argon2_position_t position = { r, 0, (uint8_t)s, 0 };
+            xmrig_ar2_fill_segment_multi((const argon2_instance_t *const *)instances, count, position);
+        }
+    }
+    return ARGON2_OK;
+}
+
 int xmrig_ar2_validate_inputs(const argon2_context *context) {
     if (NULL == context) {
         return ARGON2_INCORRECT_PARAMETER;
@@ -217,4 +217,22 @@ void xmrig_ar2_fill_segment(const argon2_instance_t *instance, argon2_position_t
  */
 int xmrig_ar2_fill_memory_blocks(argon2_instance_t *instance);
 
+/*
+ * Same as xmrig_ar2_fill_segment, but for several independent single lane
+ * instances with identical parameters, computed interleaved when the selected
+ * implementation supports it
+ * @param instances Array of @count instance pointers
+ * @param count Number of instances, at most ARGON2_MAX_MULTI_HASHES
+ * @param position Current position, the lane must be 0
+ */
+void xmrig_ar2_fill_segment_multi(const argon2_instance_t *const *instances, size_t count, argon2_position_t position);
+
+/*
+ * Same as xmrig_ar2_fill_memory_blocks for several single lane instances
+ * @param instances Array of @count instance pointers
+ * @param count Number of instances, at most ARGON2_MAX_MULTI_HASHES
+ * @return ARGON2_OK if successful
+ */
+int xmrig_ar2_fill_memory_blocks_multi(argon2_instance_t *const *instances, size_t count);
+
 #endif
@@ -17,7 +17,7 @@ extern uint64_t uv_hrtime(void);
 #endif
 
 
-static argon2_impl selected_argon_impl = { "default", NULL, fill_segment_default };
+static argon2_impl selected_argon_impl = { "default", NULL, fill_segment_default, NULL };
 
 
 /* the benchmark routine is not thread-safe, so we can use a global var here: */
@@ -92,12 +92,53 @@ void xmrig_ar2_fill_segment(const argon2_instance_t *instance, argon2_position_t
 }
 
 
+void xmrig_ar2_fill_segment_multi(const argon2_instance_t *const *instances, size_t count, argon2_position_t position)
+{
+    if (selected_argon_impl.fill_segment_multi != NULL) {
+        selected_argon_impl.fill_segment_multi(instances, count, position);
+
+        return;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        selected_argon_impl.fill_segment(instances[i], position);
+    }
+}
+
+
 const char *argon2_get_impl_name()
 {
     return selected_argon_impl.name;
 }
 
 
+size_t argon2_get_impl_count()
+{
+    argon2_impl_list impls;
+    argon2_get_impl_list(&impls);
+
+    return impls.count;
+}
+
+
+const char *argon2_get_available_impl_name(size_t index)
+{
+    argon2_impl_list impls;
+    argon2_get_impl_list(&impls);
+
+    if (index >= impls.count) {
+        return NULL;
+    }
+
+    const argon2_impl *impl = &impls.entries[index];
+    if (impl->check != NULL && !impl->check()) {
+        return NULL;
+    }
+
+    return impl->name;
+}
+
+
 int argon2_select_impl_by_name(const char *name)
 {
     argon2_impl_list impls;
@@ -115,3 +156,46 @@ int argon2_select_impl_by_name(const char *name)
 
     return 0;
 }
+
+
+int argon2_fill_with_impl(size_t index, void *memory, uint32_t m_cost, uint32_t t_cost)
+{
+    argon2_impl_list impls;
+    argon2_get_impl_list(&impls);
+
+    if (index >= impls.count) {
+        return 0;
+    }
+
+    const argon2_impl *impl = &impls.entries[index];
+    if (impl->check != NULL && !impl->check()) {
+        return 0;
+    }
+
+    /* the implementation is called directly, the selected one is not touched: */
+    void (*fill_segment)(const argon2_instance_t *, argon2_position_t) = impl->fill_segment;
+
+    argon2_instance_t instance;
+    memset(&instance, 0, sizeof(instance));
+    instance.version        = ARGON2_VERSION_NUMBER;
+    instance.memory         = (block *)memory;
+    instance.passes         = t_cost;
+    instance.memory_blocks  = m_cost;
+    instance.segment_length = m_cost / ARGON2_SYNC_POINTS;
+    instance.lane_length    = instance.segment_length * ARGON2_SYNC_POINTS;
+    instance.lanes          = 1;
+    instance.threads        = 1;
+    instance.type           = Argon2_id;
+
+    argon2_position_t pos;
+    pos.lane    = 0;
+    pos.index   = 0;
+
+    for (pos.pass = 0; pos.pass < t_cost; pos.pass++) {
+        for (pos.slice = 0; pos.slice < ARGON2_SYNC_POINTS; pos.slice++) {
+            fill_segment(&instance, pos);
+        }
+    }
+
+    return 1;
+}
@@ -8,6 +8,9 @@ typedef struct Argon2_impl {
     int (*check)(void);
     void (*fill_segment)(const argon2_instance_t *instance,
                          argon2_position_t position);
+    /* optional, interleaved fill_segment for several single lane instances */
+    void (*fill_segment_multi)(const argon2_instance_t *const *instances,
+                               size_t count, argon2_position_t position);
 } argon2_impl;
 
 typedef struct Argon2_impl_list {
@@ -16,6 +16,7 @@
  *   along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <mutex>
 
 
@@ -44,7 +45,16 @@
 
 
 #ifdef XMRIG_ALGO_ARGON2
+#   include "base/tools/Baton.h"
 #   include "crypto/argon2/Impl.h"
+
+
+#   include <uv.h>
+#endif
+
+
+#ifdef XMRIG_FEATURE_ASM
+#   include "crypto/cn/CnRProgram.h"
 #endif
 
 
@@ -61,9 +71,43 @@ extern template class Threads<CpuThreads>;
 
 
 static const String kType   = "cpu";
+static constexpr uint64_t kSweepStep = 20000;
 static std::mutex mutex;
 
 
+#ifdef XMRIG_ALGO_ARGON2
+class CpuBackendPrivate;
+
+
+class Argon2TuneBaton : public Baton<uv_work_t>
+{
+public:
+    inline Argon2TuneBaton(CpuBackendPrivate *d, const Algorithm &algorithm, size_t threads) :
+        algorithm(algorithm),
+        d(d),
+        threads(threads)
+    {}
+
+    const Algorithm algorithm;
+    CpuBackendPrivate *d;
+    const size_t threads;
+    String best;
+};
+
+
+static void selectArgon2(const Config *config)
+{
+    if (argon2::Impl::select(config->cpu().argon2Impl())) {
+        LOG_INFO("%s use " WHITE_BOLD("argon2") " implementation " CSI "1;%dm" "%s",
+                 Tags::cpu(),
+                 argon2::Impl::name() == "default" ? 33 : 32,
+                 argon2::Impl::name().data()
+                 );
+    }
+}
+#endif
+
+
 struct CpuLaunchStatus
 {
 public:
@@ -154,6 +198,17 @@ public:
 
         status.start(threads, algo.l3());
 
+        const auto &data     = threads.front();
+        const CnLayout layout = data.layout.resolve(algo, data.av(), data.assembly);
+        if (data.layout.overlap() > 1 && layout.overlap() != data.layout.overlap()) {
+            LOG_WARN("%s " WHITE_BOLD("cn-layout") YELLOW(" overlap %zu ignored, only supported by the interleaved cn-heavy kernel"), Tags::cpu(), data.layout.overlap());
+        }
+
+        sweep   = layout.isSweep() ? 0 : CnLayout::kSweepColours.size();
+        sweepTs = Chrono::steadyMSecs();
+        sweepResults.clear();
+        CnLayout::setSweepColour(CnLayout::kSweepColours.front());
+
 #       ifdef XMRIG_FEATURE_BENCHMARK
         workers.start(threads, benchmark);
 #       else
@@ -162,6 +217,68 @@ public:
     }
 
 
+    // Live workers run each sweep colour for kSweepStep ms, the second half of each step is measured.
+    void sweepLayout()
+    {
+        if (sweep >= CnLayout::kSweepColours.size() || !workers.hashrate()) {
+            return;
+        }
+
+        const uint64_t now = Chrono::steadyMSecs();
+        const auto hashrate = workers.hashrate()->calc(kSweepStep / 2);
+
+        if (!hashrate.first) {
+            sweepTs = now;
+
+            return;
+        }
+
+        if (now - sweepTs < kSweepStep) {
+            return;
+        }
+
+        LOG_INFO("%s " WHITE_BOLD("cn-layout") " colour " CYAN_BOLD("%4zu") " %.1f H/s", Tags::cpu(), CnLayout::kSweepColours[sweep], hashrate.second);
+
+        sweepResults.push_back(hashrate.second);
+        sweepTs = now;
+
+        if (++sweep < CnLayout::kSweepColours.size()) {
+            return CnLayout::setSweepColour(CnLayout::kSweepColours[sweep]);
+        }
+
+        const size_t best = std::max_element(sweepResults.begin(), sweepResults.end()) - sweepResults.begin();
+        CnLayout::setSweepColour(CnLayout::kSweepColours[best]);
+
+        LOG_INFO("%s " WHITE_BOLD("cn-layout") " sweep done, best colour " GREEN_BOLD("%zu"), Tags::cpu(), CnLayout::kSweepColours[best]);
+    }
+
+
+#   ifdef XMRIG_ALGO_ARGON2
+    void onArgon2Tuned(const String &best)
+    {
+        auto config  = controller->config();
+        argon2Tuning = false;
+
+        if (!best.isEmpty()) {
+            config->setArgon2Tuned(best);
+
+            if (config->isAutoSave()) {
+                config->save();
+            }
+        }
+
+        argon2::Impl::setTuned();
+        selectArgon2(config);
+
+        // setJob() kept the workers stopped while the benchmark was running
+        if (argon2Deferred && !threads.empty()) {
+            argon2Deferred = false;
+            start();
+        }
+    }
+#   endif
+
+
     size_t ways() const
     {
         std::lock_guard<std::mutex> lock(mutex);
@@ -205,9 +322,17 @@ public:
     Controller *controller;
     CpuLaunchStatus status;
     std::vector<CpuLaunchData> threads;
+    size_t sweep        = 0;
+    std::vector<double> sweepResults;
     String profileName;
+    uint64_t sweepTs    = 0;
     Workers<CpuLaunchData> workers;
 
+#   ifdef XMRIG_ALGO_ARGON2
+    bool argon2Deferred = false;
+    bool argon2Tuning   = false;
+#   endif
+
 #   ifdef XMRIG_FEATURE_BENCHMARK
     std::shared_ptr<Benchmark> benchmark;
 #   endif
@@ -268,6 +393,8 @@ bool xmrig::CpuBackend::isEnabled(const Algorithm &algorithm) const
 
 bool xmrig::CpuBackend::tick(uint64_t ticks)
 {
+    d_ptr->sweepLayout();
+
     return d_ptr->workers.tick(ticks);
 }
 
@@ -295,13 +422,39 @@ void xmrig::CpuBackend::prepare(const Job &nextJob)
 #   ifdef XMRIG_ALGO_ARGON2
     const auto f = nextJob.algorithm().family();
     if ((f == Algorithm::ARGON2) || (f == Algorithm::RANDOM_X)) {
-        if (argon2::Impl::select(d_ptr->controller->config()->cpu().argon2Impl())) {
-            LOG_INFO("%s use " WHITE_BOLD("argon2") " implementation " CSI "1;%dm" "%s",
-                     Tags::cpu(),
-                     argon2::Impl::name() == "default" ? 33 : 32,
-                     argon2::Impl::name().data()
-                     );
+        auto config = d_ptr->controller->config();
+
+        // No implementation forced or remembered for this CPU model: benchmark them once on a libuv worker thread,
+        // so the main loop keeps serving the pools. Workers are not started until it finishes, see setJob().
+        if (f == Algorithm::ARGON2 && config->cpu().argon2Impl().isEmpty() && !argon2::Impl::isTuned() && !d_ptr->argon2Tuning) {
+            const size_t threads = config->cpu().threads().get(nextJob.algorithm()).count();
+
+            if (threads > 0) {
+                LOG_INFO("%s " WHITE_BOLD("argon2") " benchmarking implementations on " CYAN_BOLD("%zu") " threads", Tags::cpu(), threads);
+
+                d_ptr->argon2Tuning = true;
+                auto baton = new Argon2TuneBaton(d_ptr, nextJob.algorithm(), threads);
+
+                uv_queue_work(uv_default_loop(), &baton->req,
+                    [](uv_work_t *req) {
+                        auto baton = static_cast<Argon2TuneBaton*>(req->data);
+
+                        baton->best = argon2::Impl::tune(baton->algorithm, baton->threads);
+                    },
+                    [](uv_work_t *req, int status) {
+                        auto baton = static_cast<Argon2TuneBaton*>(req->data);
+
+                        if (status == 0) {
+                            baton->d->onArgon2Tuned(baton->best);
+                        }
+
+                        delete baton;
+                    }
+                );
+            }
         }
+
+        selectArgon2(config);
     }
 #   endif
 }
@@ -351,6 +504,10 @@ void xmrig::CpuBackend::setJob(const Job &job)
 
     const auto &cpu = d_ptr->controller->config()->cpu();
 
+#   ifdef XMRIG_FEATURE_ASM
+    CnRProgram::prepare(job.algorithm(), job.height(), cpu.assembly().id(), cpu.isHwAES());
+#   endif
+
     auto threads = cpu.get(d_ptr->controller->miner(), job.algorithm());
     if (!d_ptr->threads.empty() && d_ptr->threads.size() == threads.size() && std::equal(d_ptr->threads.begin(), d_ptr->threads.end(), threads.begin())) {
         return;
@@ -374,6 +531,15 @@ void xmrig::CpuBackend::setJob(const Job &job)
 #   endif
 
     d_ptr->threads = std::move(threads);
+
+#   ifdef XMRIG_ALGO_ARGON2
+    if (d_ptr->argon2Tuning) {
+        d_ptr->argon2Deferred = true;
+
+        return;
+    }
+#   endif
+
     d_ptr->start();
 }
 
@@ -396,6 +562,10 @@ void xmrig::CpuBackend::start(IWorker *worker, bool ready)
 
 void xmrig::CpuBackend::stop()
 {
+#   ifdef XMRIG_ALGO_ARGON2
+    d_ptr->argon2Deferred = false;
+#   endif
+
     if (d_ptr->threads.empty()) {
         return;
     }
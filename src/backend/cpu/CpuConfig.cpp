@@ -27,6 +27,7 @@
 
 namespace xmrig {
 
+const char *CpuConfig::kCnLayout            = "cn-layout";
 const char *CpuConfig::kEnabled             = "enabled";
 const char *CpuConfig::kField               = "cpu";
 const char *CpuConfig::kHugePages           = "huge-pages";
@@ -45,6 +46,10 @@ const char *CpuConfig::kAsm                 = "asm";
 const char *CpuConfig::kArgon2Impl          = "argon2-impl";
 #endif
 
+#ifdef XMRIG_ALGO_KAWPOW
+const char *CpuConfig::kKawPowDAG           = "kawpow-dag";
+#endif
+
 
 extern template class Threads<CpuThreads>;
 
@@ -71,6 +76,7 @@ rapidjson::Value xmrig::CpuConfig::toJSON(rapidjson::Document &doc) const
     obj.AddMember(StringRef(kPriority),     priority() != -1 ? Value(priority()) : Value(kNullType), allocator);
     obj.AddMember(StringRef(kMemoryPool),   m_memoryPool < 1 ? Value(m_memoryPool < 0) : Value(m_memoryPool), allocator);
     obj.AddMember(StringRef(kYield),        m_yield, allocator);
+    obj.AddMember(StringRef(kCnLayout),     m_cnLayout.toJSON(doc), allocator);
 
     if (m_threads.isEmpty()) {
         obj.AddMember(StringRef(kMaxThreadsHint), m_limit, allocator);
@@ -81,7 +87,22 @@ rapidjson::Value xmrig::CpuConfig::toJSON(rapidjson::Document &doc) const
 #   endif
 
 #   ifdef XMRIG_ALGO_ARGON2
-    obj.AddMember(StringRef(kArgon2Impl), m_argon2Impl.toJSON(), allocator);
+    if (m_argon2Impl.isEmpty() && !m_argon2Tuned.empty()) {
+        Value tuned(kObjectType);
+
+        for (const auto &kv : m_argon2Tuned) {
+            tuned.AddMember(kv.first.toJSON(doc), kv.second.toJSON(doc), allocator);
+        }
+
+        obj.AddMember(StringRef(kArgon2Impl), tuned, allocator);
+    }
+    else {
+        obj.AddMember(StringRef(kArgon2Impl), m_argon2Impl.toJSON(), allocator);
+    }
+#   endif
+
+#   ifdef XMRIG_ALGO_KAWPOW
+    obj.AddMember(StringRef(kKawPowDAG), m_kawpowDAG, allocator);
 #   endif
 
     m_threads.toJSON(obj, doc);
@@ -134,6 +155,7 @@ void xmrig::CpuConfig::read(const rapidjson::Value &value)
         m_hugePagesJit = Json::getBool(value, kHugePagesJit, m_hugePagesJit);
         m_limit        = Json::getUint(value, kMaxThreadsHint, m_limit);
         m_yield        = Json::getBool(value, kYield, m_yield);
+        m_cnLayout     = Json::getValue(value, kCnLayout);
 
         setAesMode(Json::getValue(value, kHwAes));
         setHugePages(Json::getValue(value, kHugePages));
@@ -145,7 +167,11 @@ void xmrig::CpuConfig::read(const rapidjson::Value &value)
 #       endif
 
 #       ifdef XMRIG_ALGO_ARGON2
-        m_argon2Impl = Json::getString(value, kArgon2Impl);
+        setArgon2Impl(Json::getValue(value, kArgon2Impl));
+#       endif
+
+#       ifdef XMRIG_ALGO_KAWPOW
+        m_kawpowDAG = Json::getBool(value, kKawPowDAG, m_kawpowDAG);
 #       endif
 
         m_threads.read(value);
@@ -163,6 +189,27 @@ void xmrig::CpuConfig::read(const rapidjson::Value &value)
 }
 
 
+#ifdef XMRIG_ALGO_ARGON2
+const xmrig::String &xmrig::CpuConfig::argon2Impl() const
+{
+    if (m_argon2Impl.isEmpty()) {
+        const auto it = m_argon2Tuned.find(Cpu::info()->brand());
+        if (it != m_argon2Tuned.end()) {
+            return it->second;
+        }
+    }
+
+    return m_argon2Impl;
+}
+
+
+void xmrig::CpuConfig::setArgon2Tuned(const String &impl)
+{
+    m_argon2Tuned[Cpu::info()->brand()] = impl;
+}
+#endif
+
+
 void xmrig::CpuConfig::generate()
 {
     if (!isEnabled() || m_threads.has("*")) {
@@ -195,6 +242,23 @@ void xmrig::CpuConfig::setAesMode(const rapidjson::Value &value)
 }
 
 
+#ifdef XMRIG_ALGO_ARGON2
+void xmrig::CpuConfig::setArgon2Impl(const rapidjson::Value &value)
+{
+    if (value.IsString()) {
+        m_argon2Impl = value.GetString();
+    }
+    else if (value.IsObject()) {
+        for (auto it = value.MemberBegin(); it != value.MemberEnd(); ++it) {
+            if (it->value.IsString()) {
+                m_argon2Tuned.insert({ it->name.GetString(), it->value.GetString() });
+            }
+        }
+    }
+}
+#endif
+
+
 void xmrig::CpuConfig::setHugePages(const rapidjson::Value &value)
 {
     if (value.IsBool()) {
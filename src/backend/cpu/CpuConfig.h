@@ -23,6 +23,7 @@
 #include "backend/common/Threads.h"
 #include "backend/cpu/CpuLaunchData.h"
 #include "backend/cpu/CpuThreads.h"
+#include "crypto/cn/CnLayout.h"
 #include "crypto/common/Assembly.h"
 
 
@@ -40,6 +41,7 @@ public:
 
     static const char *kEnabled;
     static const char *kField;
+    static const char *kCnLayout;
     static const char *kHugePages;
     static const char *kHugePagesJit;
     static const char *kHwAes;
@@ -56,6 +58,10 @@ public:
     static const char *kArgon2Impl;
 #   endif
 
+#   ifdef XMRIG_ALGO_KAWPOW
+    static const char *kKawPowDAG;
+#   endif
+
     CpuConfig() = default;
 
     bool isHwAES() const;
@@ -64,13 +70,19 @@ public:
     std::vector<CpuLaunchData> get(const Miner *miner, const Algorithm &algorithm) const;
     void read(const rapidjson::Value &value);
 
+#   ifdef XMRIG_ALGO_ARGON2
+    const String &argon2Impl() const;
+    void setArgon2Tuned(const String &impl);
+#   endif
+
     inline bool isEnabled() const                       { return m_enabled; }
     inline bool isHugePages() const                     { return m_hugePageSize > 0; }
     inline bool isHugePagesJit() const                  { return m_hugePagesJit; }
+    inline bool isKawPowDAG() const                     { return m_kawpowDAG; }
     inline bool isShouldSave() const                    { return m_shouldSave; }
     inline bool isYield() const                         { return m_yield; }
     inline const Assembly &assembly() const             { return m_assembly; }
-    inline const String &argon2Impl() const             { return m_argon2Impl; }
+    inline const CnLayout &cnLayout() const             { return m_cnLayout; }
     inline const Threads<CpuThreads> &threads() const   { return m_threads; }
     inline int priority() const                         { return m_priority; }
     inline size_t hugePageSize() const                  { return m_hugePageSize * 1024U; }
@@ -85,18 +97,25 @@ private:
     void setHugePages(const rapidjson::Value &value);
     void setMemoryPool(const rapidjson::Value &value);
 
+#   ifdef XMRIG_ALGO_ARGON2
+    void setArgon2Impl(const rapidjson::Value &value);
+#   endif
+
     inline void setPriority(int priority)   { m_priority = (priority >= -1 && priority <= 5) ? priority : -1; }
 
     AesMode m_aes           = AES_AUTO;
     Assembly m_assembly;
     bool m_enabled          = true;
     bool m_hugePagesJit     = false;
+    bool m_kawpowDAG        = false;
     bool m_shouldSave       = false;
     bool m_yield            = true;
+    CnLayout m_cnLayout;
     int m_memoryPool        = 0;
     int m_priority          = -1;
     size_t m_hugePageSize   = kDefaultHugePageSizeKb;
     String m_argon2Impl;
+    std::map<String, String> m_argon2Tuned;
     Threads<CpuThreads> m_threads;
     uint32_t m_limit        = 100;
 };
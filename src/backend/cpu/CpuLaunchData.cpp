@@ -38,6 +38,7 @@ xmrig::CpuLaunchData::CpuLaunchData(const Miner *miner, const Algorithm &algorit
     hugePages(config.isHugePages()),
     hwAES(config.isHwAES()),
     yield(config.isYield()),
+    layout(config.cnLayout()),
     priority(config.priority()),
     affinity(thread.affinity()),
     miner(miner),
@@ -55,6 +56,7 @@ bool xmrig::CpuLaunchData::isEqual(const CpuLaunchData &other) const
             && hugePages        == other.hugePages
             && hwAES            == other.hwAES
             && intensity        == other.intensity
+            && layout           == other.layout
             && priority         == other.priority
             && affinity         == other.affinity
             );
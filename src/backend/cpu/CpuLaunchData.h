@@ -29,6 +29,7 @@
 
 #include "base/crypto/Algorithm.h"
 #include "crypto/cn/CnHash.h"
+#include "crypto/cn/CnLayout.h"
 #include "crypto/common/Assembly.h"
 #include "crypto/common/Nonce.h"
 
@@ -61,6 +62,7 @@ public:
     const bool hugePages;
     const bool hwAES;
     const bool yield;
+    const CnLayout layout;
     const int priority;
     const int64_t affinity;
     const Miner *miner;
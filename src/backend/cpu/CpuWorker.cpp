@@ -37,6 +37,7 @@
 #include "crypto/rx/RxDataset.h"
 #include "crypto/rx/RxVm.h"
 #include "crypto/ghostrider/ghostrider.h"
+#include "net/JobLatency.h"
 #include "net/JobResults.h"
 
 
@@ -54,12 +55,6 @@ namespace xmrig {
 
 static constexpr uint32_t kReserveCount = 32768;
 
-
-#ifdef XMRIG_ALGO_CN_HEAVY
-static std::mutex cn_heavyZen3MemoryMutex;
-VirtualMemory* cn_heavyZen3Memory = nullptr;
-#endif
-
 } // namespace xmrig
 
 
@@ -74,28 +69,11 @@ xmrig::CpuWorker<N>::CpuWorker(size_t id, const CpuLaunchData &data) :
     m_av(data.av()),
     m_miner(data.miner),
     m_threads(data.threads),
+    m_layout(data.layout.resolve(data.algorithm, m_av, m_assembly)),
     m_ctx()
 {
-#   ifdef XMRIG_ALGO_CN_HEAVY
-    // cn-heavy optimization for Zen3 CPUs
-    const auto arch = Cpu::info()->arch();
-    const uint32_t model = Cpu::info()->model();
-    const bool is_vermeer = (arch == ICpuInfo::ARCH_ZEN3) && (model == 0x21);
-    const bool is_raphael = (arch == ICpuInfo::ARCH_ZEN4) && (model == 0x61);
-    if ((N == 1) && (m_av == CnHash::AV_SINGLE) && (m_algorithm.family() == Algorithm::CN_HEAVY) && (m_assembly != Assembly::NONE) && (is_vermeer || is_raphael)) {
-        std::lock_guard<std::mutex> lock(cn_heavyZen3MemoryMutex);
-        if (!cn_heavyZen3Memory) {
-            // Round up number of threads to the multiple of 8
-            const size_t num_threads = ((m_threads + 7) / 8) * 8;
-            cn_heavyZen3Memory = new VirtualMemory(m_algorithm.l3() * num_threads, data.hugePages, false, false, node(), VirtualMemory::kDefaultHugePageSize);
-        }
-        m_memory = cn_heavyZen3Memory;
-    }
-    else
-#   endif
-    {
-        m_memory = new VirtualMemory(m_algorithm.l3() * N, data.hugePages, false, true, node(), VirtualMemory::kDefaultHugePageSize);
-    }
+    m_colour = m_layout.isSweep() ? CnLayout::sweepColour() : m_layout.colour();
+    m_memory = CnLayout::acquire(m_layout, m_algorithm.l3(), N, id, data.affinities, node(), data.hugePages, m_slot);
 
 #   ifdef XMRIG_ALGO_GHOSTRIDER
     m_ghHelper = ghostrider::create_helper_thread(affinity(), data.priority, data.affinities);
@@ -111,13 +89,7 @@ xmrig::CpuWorker<N>::~CpuWorker()
 #   endif
 
     CnCtx::release(m_ctx, N);
-
-#   ifdef XMRIG_ALGO_CN_HEAVY
-    if (m_memory != cn_heavyZen3Memory)
-#   endif
-    {
-        delete m_memory;
-    }
+    CnLayout::release(m_memory);
 
 #   ifdef XMRIG_ALGO_GHOSTRIDER
     ghostrider::destroy_helper_thread(m_ghHelper);
@@ -144,7 +116,9 @@ void xmrig::CpuWorker<N>::allocateRandomX_VM()
     if (!m_vm) {
         // Try to allocate scratchpad from dataset's 1 GB huge pages, if normal huge pages are not available
         uint8_t* scratchpad = m_memory->isHugePages() ? m_memory->scratchpad() : dataset->tryAllocateScrathpad();
-        m_vm = RxVm::create(dataset, scratchpad ? scratchpad : m_memory->scratchpad(), !m_hwAES, m_assembly, node());
+        scratchpad = scratchpad ? scratchpad : m_memory->scratchpad();
+        m_vm = RxVm::create(dataset, scratchpad, !m_hwAES, m_assembly, node());
+        RxVm::printPlacement(m_vm, scratchpad, id(), node());
     }
     else if (!dataset->get() && (m_job.currentJob().seed() != m_seed)) {
         // Update RandomX light VM with the new seed
@@ -326,7 +300,12 @@ void xmrig::CpuWorker<N>::start()
 #               endif
 
                 default:
-                    fn(job.algorithm())(m_job.blob(), job.size(), m_hash, m_ctx, job.height());
+                    if (m_layout.isSweep() && m_colour != CnLayout::sweepColour()) {
+                        m_colour = CnLayout::sweepColour();
+                        placeCnCtx();
+                    }
+
+                    m_fn(m_job.blob(), job.size(), m_hash, m_ctx, job.height());
                     break;
                 }
 
@@ -484,16 +463,17 @@ template<size_t N>
 void xmrig::CpuWorker<N>::allocateCnCtx()
 {
     if (m_ctx[0] == nullptr) {
-        int shift = 0;
+        CnCtx::create(m_ctx, m_memory->scratchpad(), m_algorithm.l3(), N);
+        placeCnCtx();
+    }
+}
 
-#       ifdef XMRIG_ALGO_CN_HEAVY
-        // cn-heavy optimization for Zen3 CPUs
-        if (m_memory == cn_heavyZen3Memory) {
-            shift = (id() / 8) * m_algorithm.l3() * 8 + (id() % 8) * 64;
-        }
-#       endif
 
-        CnCtx::create(m_ctx, m_memory->scratchpad() + shift, m_algorithm.l3(), N);
+template<size_t N>
+void xmrig::CpuWorker<N>::placeCnCtx()
+{
+    for (size_t i = 0; i < N; ++i) {
+        m_ctx[i]->memory = m_memory->scratchpad() + m_layout.offset(m_algorithm.l3(), N, m_slot, i, m_colour);
     }
 }
 
@@ -523,8 +503,18 @@ void xmrig::CpuWorker<N>::consumeJob()
     else
 #   endif
     {
+        // Resolved once per job, the inner loop only calls it; GhostRider hashes through its own path
+        m_fn = m_job.currentJob().algorithm().family() != Algorithm::GHOSTRIDER ? fn(m_job.currentJob().algorithm()) : nullptr;
+
         allocateCnCtx();
     }
+
+    // Resuming after a pause hands out the same job again, only its first start is the latency of interest
+    if (job.trace(Job::TRACE_READY) != m_traced) {
+        m_traced = job.trace(Job::TRACE_READY);
+
+        JobLatency::started(job);
+    }
 }
 
 
@@ -82,6 +82,7 @@ private:
     bool verify2(const Algorithm &algorithm, const uint8_t *referenceValue);
     void allocateCnCtx();
     void consumeJob();
+    void placeCnCtx();
 
     alignas(8) uint8_t m_hash[N * 32]{ 0 };
     const Algorithm m_algorithm;
@@ -91,7 +92,12 @@ private:
     const CnHash::AlgoVariant m_av;
     const Miner *m_miner;
     const size_t m_threads;
+    const CnLayout m_layout;
+    cn_hash_fun m_fn        = nullptr;
     cryptonight_ctx *m_ctx[N];
+    size_t m_colour         = 0;
+    size_t m_slot           = 0;
+    uint64_t m_traced       = 0;
     VirtualMemory *m_memory = nullptr;
     WorkerJob<N> m_job;
 
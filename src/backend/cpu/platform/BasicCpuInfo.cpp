@@ -314,6 +314,7 @@ xmrig::BasicCpuInfo::BasicCpuInfo() :
 
     cn_sse41_enabled = has(FLAG_SSE41);
     cn_vaes_enabled = has(FLAG_VAES);
+    cn_vaes512_enabled = has(FLAG_VAES) && has(FLAG_AVX512F);
 }
 
 
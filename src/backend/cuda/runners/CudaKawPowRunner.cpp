@@ -51,15 +51,14 @@ bool xmrig::CudaKawPowRunner::set(const Job &job, uint8_t *blob)
     const uint64_t height = job.height();
     const uint32_t epoch = height / KPHash::EPOCH_LENGTH;
 
-    KPCache& cache = KPCache::s_cache;
-    {
-        std::lock_guard<std::mutex> lock(KPCache::s_cacheMutex);
-        cache.init(epoch);
+    const auto cache = KPCache::get(epoch);
+    if (!cache) {
+        return false;
     }
 
     const uint64_t start_ms = Chrono::steadyMSecs();
 
-    const bool result = CudaLib::kawPowPrepare(m_ctx, cache.data(), cache.size(), cache.l1_cache(), KPCache::dag_size(epoch), height, dag_sizes);
+    const bool result = CudaLib::kawPowPrepare(m_ctx, cache->data(), cache->size(), cache->l1_cache(), KPCache::dag_size(epoch), height, dag_sizes);
     if (!result) {
         LOG_ERR("%s " YELLOW("KawPow") RED(" failed to initialize DAG: ") RED_BOLD("%s"), Tags::nvidia(), CudaLib::lastError(m_ctx));
     }
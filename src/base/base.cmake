@@ -59,7 +59,10 @@ set(HEADERS_BASE
     src/base/net/stratum/Pools.h
     src/base/net/stratum/ProxyUrl.h
     src/base/net/stratum/Socks5.h
+    src/base/net/stratum/StratumReader.h
     src/base/net/stratum/strategies/FailoverStrategy.h
+    src/base/net/stratum/strategies/LatencyStrategy.h
+    src/base/net/stratum/strategies/PoolRtt.h
     src/base/net/stratum/strategies/SinglePoolStrategy.h
     src/base/net/stratum/strategies/StrategyProxy.h
     src/base/net/stratum/SubmitResult.h
@@ -127,7 +130,9 @@ set(SOURCES_BASE
     src/base/net/stratum/Pools.cpp
     src/base/net/stratum/ProxyUrl.cpp
     src/base/net/stratum/Socks5.cpp
+    src/base/net/stratum/StratumReader.cpp
     src/base/net/stratum/strategies/FailoverStrategy.cpp
+    src/base/net/stratum/strategies/LatencyStrategy.cpp
     src/base/net/stratum/strategies/SinglePoolStrategy.cpp
     src/base/net/stratum/Url.cpp
     src/base/net/tools/LineReader.cpp
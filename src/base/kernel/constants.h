@@ -26,6 +26,7 @@
 
 constexpr size_t      XMRIG_NET_BUFFER_CHUNK_SIZE           = 64 * 1024;
 constexpr size_t      XMRIG_NET_BUFFER_INIT_CHUNKS          = 4;
+constexpr size_t      XMRIG_NET_LINE_MAX_SIZE               = 16 * 1024 * 1024;
 
 
 #endif /* XMRIG_CONSTANTS_H */
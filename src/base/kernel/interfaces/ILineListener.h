@@ -44,6 +44,7 @@ public:
     virtual ~ILineListener()    = default;
 
     virtual void onLine(char *line, size_t size) = 0;
+    virtual void onLineTooLong(size_t size)      = 0;
 };
 
 
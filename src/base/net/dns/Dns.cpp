@@ -18,6 +18,7 @@
 
 
 #include "base/net/dns/Dns.h"
+#include "3rdparty/rapidjson/document.h"
 #include "base/net/dns/DnsRequest.h"
 #include "base/net/dns/DnsUvBackend.h"
 
@@ -25,6 +26,7 @@
 namespace xmrig {
 
 
+Dns::Counters Dns::m_counters;
 DnsConfig Dns::m_config;
 std::map<String, std::shared_ptr<IDnsBackend>> Dns::m_backends;
 
@@ -32,6 +34,21 @@ std::map<String, std::shared_ptr<IDnsBackend>> Dns::m_backends;
 } // namespace xmrig
 
 
+rapidjson::Value xmrig::Dns::toJSON(rapidjson::Document &doc)
+{
+    using namespace rapidjson;
+
+    auto &allocator = doc.GetAllocator();
+    Value obj(kObjectType);
+
+    obj.AddMember("hits",   m_counters.hits, allocator);
+    obj.AddMember("stale",  m_counters.stale, allocator);
+    obj.AddMember("misses", m_counters.misses, allocator);
+
+    return obj;
+}
+
+
 std::shared_ptr<xmrig::DnsRequest> xmrig::Dns::resolve(const String &host, IDnsListener *listener)
 {
     auto req = std::make_shared<DnsRequest>(listener);
@@ -44,3 +61,12 @@ std::shared_ptr<xmrig::DnsRequest> xmrig::Dns::resolve(const String &host, IDnsL
 
     return req;
 }
+
+
+void xmrig::Dns::preresolve(const String &host)
+{
+    // Nobody waits for the answer, the backend only holds a weak reference to the request and just fills the cache
+    if (!host.isEmpty()) {
+        resolve(host, nullptr);
+    }
+}
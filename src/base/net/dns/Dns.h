@@ -40,12 +40,24 @@ class IDnsListener;
 class Dns
 {
 public:
+    // Cache lookups: answered from fresh records, answered from expired records while they are refreshed, or waited for the resolver
+    struct Counters
+    {
+        uint64_t hits   = 0;
+        uint64_t stale  = 0;
+        uint64_t misses = 0;
+    };
+
     inline static const DnsConfig &config()             { return m_config; }
+    inline static Counters &counters()                  { return m_counters; }
     inline static void set(const DnsConfig &config)     { m_config = config; }
 
+    static rapidjson::Value toJSON(rapidjson::Document &doc);
     static std::shared_ptr<DnsRequest> resolve(const String &host, IDnsListener *listener);
+    static void preresolve(const String &host);
 
 private:
+    static Counters m_counters;
     static DnsConfig m_config;
     static std::map<String, std::shared_ptr<IDnsBackend> > m_backends;
 };
@@ -28,8 +28,10 @@ namespace xmrig {
 
 
 const char *DnsConfig::kField   = "dns";
-const char *DnsConfig::kIPv     = "ip_version";
-const char *DnsConfig::kTTL     = "ttl";
+const char *DnsConfig::kIPv         = "ip_version";
+const char *DnsConfig::kMaxStale    = "max-stale";
+const char *DnsConfig::kPreresolve  = "preresolve";
+const char *DnsConfig::kTTL         = "ttl";
 
 
 } // namespace xmrig
@@ -42,7 +44,9 @@ xmrig::DnsConfig::DnsConfig(const rapidjson::Value &value)
         m_ipv = ipv;
     }
 
-    m_ttl = std::max(Json::getUint(value, kTTL, m_ttl), 1U);
+    m_ttl        = std::max(Json::getUint(value, kTTL, m_ttl), 1U);
+    m_maxStale   = Json::getUint(value, kMaxStale, m_maxStale);
+    m_preresolve = Json::getBool(value, kPreresolve, m_preresolve);
 }
 
 
@@ -67,8 +71,10 @@ rapidjson::Value xmrig::DnsConfig::toJSON(rapidjson::Document &doc) const
     auto &allocator = doc.GetAllocator();
     Value obj(kObjectType);
 
-    obj.AddMember(StringRef(kIPv), m_ipv, allocator);
-    obj.AddMember(StringRef(kTTL), m_ttl, allocator);
+    obj.AddMember(StringRef(kIPv),         m_ipv, allocator);
+    obj.AddMember(StringRef(kTTL),         m_ttl, allocator);
+    obj.AddMember(StringRef(kMaxStale),    m_maxStale, allocator);
+    obj.AddMember(StringRef(kPreresolve),  m_preresolve, allocator);
 
     return obj;
 }
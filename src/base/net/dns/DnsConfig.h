@@ -29,20 +29,26 @@ class DnsConfig
 public:
     static const char *kField;
     static const char *kIPv;
+    static const char *kMaxStale;
+    static const char *kPreresolve;
     static const char *kTTL;
 
     DnsConfig() = default;
     DnsConfig(const rapidjson::Value &value);
 
-    inline uint32_t ipv() const { return m_ipv; }
-    inline uint32_t ttl() const { return m_ttl * 1000U; }
+    inline bool isPreresolve() const    { return m_preresolve; }
+    inline uint32_t ipv() const         { return m_ipv; }
+    inline uint64_t maxStale() const    { return m_maxStale * 1000ULL; }
+    inline uint32_t ttl() const         { return m_ttl * 1000U; }
 
     int ai_family() const;
     rapidjson::Value toJSON(rapidjson::Document &doc) const;
 
 private:
-    uint32_t m_ttl = 30U;
-    uint32_t m_ipv = 0U;
+    bool m_preresolve   = false;
+    uint32_t m_ttl      = 30U;
+    uint32_t m_ipv      = 0U;
+    uint32_t m_maxStale = 86400U;
 };
 
 
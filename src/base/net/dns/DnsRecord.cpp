@@ -37,6 +37,12 @@ const sockaddr *xmrig::DnsRecord::addr(uint16_t port) const
 }
 
 
+int xmrig::DnsRecord::family() const
+{
+    return reinterpret_cast<const sockaddr &>(m_data).sa_family;
+}
+
+
 xmrig::String xmrig::DnsRecord::ip() const
 {
     char *buf = nullptr;
@@ -34,6 +34,7 @@ public:
     DnsRecord(const addrinfo *addr);
 
     const sockaddr *addr(uint16_t port = 0) const;
+    int family() const;
     String ip() const;
 
 private:
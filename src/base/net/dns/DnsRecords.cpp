@@ -16,6 +16,7 @@
  *   along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <uv.h>
 
 #include "base/net/dns/DnsRecords.h"
@@ -111,3 +112,33 @@ const xmrig::DnsRecord &xmrig::DnsRecords::get() const
 
     return defaultRecord;
 }
+
+
+std::vector<xmrig::DnsRecord> xmrig::DnsRecords::interleaved() const
+{
+    const size_t size = m_records.size();
+    std::vector<DnsRecord> out;
+    if (!size) {
+        return out;
+    }
+
+    // RFC 8305 section 4: start with the family of the first address and alternate families after that,
+    // the starting point is rotated like get() so that connections are still spread over all addresses.
+    const size_t start = m_index++ % size;
+    const int first    = m_records[start].family();
+
+    std::vector<DnsRecord> other;
+    out.reserve(size);
+
+    for (size_t i = 0; i < size; ++i) {
+        const DnsRecord &record = m_records[(start + i) % size];
+
+        (record.family() == first ? out : other).push_back(record);
+    }
+
+    for (size_t i = 0; i < other.size(); ++i) {
+        out.insert(out.begin() + static_cast<std::ptrdiff_t>(std::min(i * 2 + 1, out.size())), other[i]);
+    }
+
+    return out;
+}
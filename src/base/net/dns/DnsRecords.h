@@ -35,6 +35,7 @@ public:
     inline size_t size() const                              { return m_records.size(); }
 
     const DnsRecord &get() const;
+    std::vector<DnsRecord> interleaved() const;
 
 private:
     mutable size_t m_index = 0;
@@ -20,6 +20,7 @@
 
 #include "base/net/dns/DnsUvBackend.h"
 #include "base/kernel/interfaces/IDnsListener.h"
+#include "base/net/dns/Dns.h"
 #include "base/net/dns/DnsConfig.h"
 #include "base/tools/Chrono.h"
 
@@ -74,18 +75,35 @@ xmrig::DnsUvBackend::~DnsUvBackend()
 void xmrig::DnsUvBackend::resolve(const String &host, const std::weak_ptr<IDnsListener> &listener, const DnsConfig &config)
 {
     m_queue.emplace_back(listener);
+    m_maxAge = config.ttl() + config.maxStale();
+
+    const uint64_t age = Chrono::currentMSecsSinceEpoch() - m_ts;
+
+    if (age <= config.ttl()) {
+        ++Dns::counters().hits;
 
-    if (Chrono::currentMSecsSinceEpoch() - m_ts <= config.ttl()) {
         return notify();
     }
 
+    // Expired records are still served right away while the refresh runs in the background, so a pool restart
+    // does not put the resolver on the reconnect path of every client
+    const bool stale = isUsable(age);
+    if (stale) {
+        ++Dns::counters().stale;
+
+        notify();
+    }
+    else {
+        ++Dns::counters().misses;
+    }
+
     if (m_req) {
         return;
     }
 
     m_ai_family = config.ai_family();
 
-    if (!resolve(host)) {
+    if (!resolve(host) && !stale) {
         notify();
     }
 }
@@ -96,9 +114,25 @@ bool xmrig::DnsUvBackend::resolve(const String &host)
     m_req = std::make_shared<uv_getaddrinfo_t>();
     m_req->data = getStorage().ptr(m_key);
 
-    m_status = uv_getaddrinfo(uv_default_loop(), m_req.get(), DnsUvBackend::onResolved, host.data(), nullptr, &hints);
+    const int rc = uv_getaddrinfo(uv_default_loop(), m_req.get(), DnsUvBackend::onResolved, host.data(), nullptr, &hints);
+    if (rc < 0) {
+        m_req.reset();
+
+        if (!isUsable(Chrono::currentMSecsSinceEpoch() - m_ts)) {
+            m_status  = rc;
+            m_records = {};
+        }
+
+        return false;
+    }
 
-    return m_status == 0;
+    return true;
+}
+
+
+bool xmrig::DnsUvBackend::isUsable(uint64_t age) const
+{
+    return m_status == 0 && !m_records.isEmpty() && age <= m_maxAge;
 }
 
 
@@ -114,27 +148,33 @@ void xmrig::DnsUvBackend::notify()
     }
 
     m_queue.clear();
-    m_req.reset();
 }
 
 
 void xmrig::DnsUvBackend::onResolved(int status, addrinfo *res)
 {
-    m_status = status;
-    m_ts     = Chrono::currentMSecsSinceEpoch();
+    m_req.reset();
 
-    if (m_status < 0) {
-        m_records = {};
+    DnsRecords records;
+    if (status >= 0) {
+        records = { res, m_ai_family };
 
-        return notify();
+        if (records.isEmpty()) {
+            status = UV_EAI_NONAME;
+        }
     }
 
-    m_records = { res, m_ai_family };
+    const uint64_t now = Chrono::currentMSecsSinceEpoch();
 
-    if (m_records.isEmpty()) {
-        m_status = UV_EAI_NONAME;
+    // A failed refresh keeps the previous records until they are too old to be served
+    if (status < 0 && isUsable(now - m_ts)) {
+        return notify();
     }
 
+    m_status  = status;
+    m_ts      = now;
+    m_records = std::move(records);
+
     notify();
 }
 
@@ -43,6 +43,7 @@ protected:
     void resolve(const String &host, const std::weak_ptr<IDnsListener> &listener, const DnsConfig &config) override;
 
 private:
+    bool isUsable(uint64_t age) const;
     bool resolve(const String &host);
     void notify();
     void onResolved(int status, addrinfo *res);
@@ -54,6 +55,7 @@ private:
     int m_status            = 0;
     std::deque<std::weak_ptr<IDnsListener>> m_queue;
     std::shared_ptr<uv_getaddrinfo_t> m_req;
+    uint64_t m_maxAge       = 0;
     uint64_t m_ts           = 0;
     uintptr_t m_key;
 
@@ -17,6 +17,7 @@
  *   along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <cassert>
 #include <cinttypes>
 #include <iterator>
@@ -50,6 +51,8 @@
 #include "base/tools/Chrono.h"
 #include "base/tools/cryptonote/BlobReader.h"
 #include "base/tools/Cvt.h"
+#include "base/tools/Handle.h"
+#include "base/tools/Timer.h"
 #include "net/JobResult.h"
 
 
@@ -62,6 +65,25 @@ namespace xmrig {
 
 Storage<Client> Client::m_storage;
 
+
+static const char kSubmitAlgo[]     = ",\"algo\":\"";
+static const char kSubmitSig[]      = ",\"sig\":\"";
+static const char kSubmitTemplate[] = "{\"id\":%" PRId64 ",\"jsonrpc\":\"2.0\",\"method\":\"submit\",\"params\":{\"id\":\"%s\",\"job_id\":\"%s\",\"nonce\":\"%s\",\"result\":\"%s\"%s%s%s%s%s%s}}\n";
+
+
+// Strings from the pool can be put into a pre-formatted request only if they need no JSON escaping
+static bool isPlain(const String &str)
+{
+    for (size_t i = 0; i < str.size(); ++i) {
+        const auto c = static_cast<uint8_t>(str.data()[i]);
+        if (c < 0x20 || c == '"' || c == '\\') {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 } /* namespace xmrig */
 
 
@@ -90,6 +112,8 @@ xmrig::Client::Client(int id, const char *agent, IClientListener *listener) :
 
 xmrig::Client::~Client()
 {
+    delete m_timer;
+    delete m_attemptTimer;
     delete m_socket;
 }
 
@@ -150,29 +174,9 @@ int64_t xmrig::Client::send(const rapidjson::Value &obj, Callback callback)
 
 int64_t xmrig::Client::send(const rapidjson::Value &obj)
 {
-    using namespace rapidjson;
-
-    StringBuffer buffer(nullptr, 512);
-    Writer<StringBuffer> writer(buffer);
-    obj.Accept(writer);
-
-    const size_t size = buffer.GetSize();
-    if (size > kMaxSendBufferSize) {
-        LOG_ERR("%s " RED("send failed: ") RED_BOLD("\"max send buffer size exceeded: %zu\""), tag(), size);
-        close();
+    const size_t size = serialize(obj);
 
-        return -1;
-    }
-
-    if (size > (m_sendBuf.size() - 2)) {
-        m_sendBuf.resize(((size + 1) / 1024 + 1) * 1024);
-    }
-
-    memcpy(m_sendBuf.data(), buffer.GetString(), size);
-    m_sendBuf[size]     = '\n';
-    m_sendBuf[size + 1] = '\0';
-
-    return send(size + 1);
+    return size ? send(size) : -1;
 }
 
 
@@ -193,45 +197,74 @@ int64_t xmrig::Client::submit(const JobResult &result)
     using namespace rapidjson;
 
 #   ifdef XMRIG_PROXY_PROJECT
-    const char *nonce = result.nonce;
-    const char *data  = result.result;
+    const char *nonce     = result.nonce;
+    const char *data      = result.result;
+    const char *signature = result.sig;
 #   else
-    char *nonce = m_tempBuf.data();
-    char *data  = m_tempBuf.data() + 16;
-    char *signature = m_tempBuf.data() + 88;
+    char *nonce     = m_tempBuf.data();
+    char *data      = m_tempBuf.data() + 16;
+    char *signature = nullptr;
 
     Cvt::toHex(nonce, sizeof(uint32_t) * 2 + 1, reinterpret_cast<const uint8_t *>(&result.nonce), sizeof(uint32_t));
     Cvt::toHex(data, 65, result.result(), 32);
 
     if (result.minerSignature()) {
+        signature = m_tempBuf.data() + 88;
         Cvt::toHex(signature, 129, result.minerSignature(), 64);
     }
 #   endif
 
-    Document doc(kObjectType);
-    auto &allocator = doc.GetAllocator();
+    const char *algo = (has<EXT_ALGO>() && result.algorithm.isValid()) ? result.algorithm.name() : nullptr;
+    size_t size      = 0;
 
-    Value params(kObjectType);
-    params.AddMember("id",     StringRef(m_rpcId.data()), allocator);
-    params.AddMember("job_id", StringRef(result.jobId.data()), allocator);
-    params.AddMember("nonce",  StringRef(nonce), allocator);
-    params.AddMember("result", StringRef(data), allocator);
+    if (isPlain(m_rpcId) && isPlain(result.jobId)) {
+        // Pre-formatted request, the same output as the generic path below without building a DOM
+        // The template length also counts its conversion specifiers, 20 more digits cover any int64_t sequence
+        const size_t max = sizeof(kSubmitTemplate) + 20 + m_rpcId.size() + result.jobId.size() + strlen(nonce) + strlen(data) +
+                           (signature ? sizeof(kSubmitSig) + strlen(signature) : 0) +
+                           (algo ? sizeof(kSubmitAlgo) + strlen(algo) : 0);
 
-#   ifndef XMRIG_PROXY_PROJECT
-    if (result.minerSignature()) {
-        params.AddMember("sig", StringRef(signature), allocator);
-    }
-#   else
-    if (result.sig) {
-        params.AddMember("sig", StringRef(result.sig), allocator);
+        if (max > m_sendBuf.size()) {
+            m_sendBuf.resize((max / 1024 + 1) * 1024);
+        }
+
+        const int rc = snprintf(m_sendBuf.data(), m_sendBuf.size(), kSubmitTemplate,
+                                m_sequence, m_rpcId.data(), result.jobId.data(), nonce, data,
+                                signature ? kSubmitSig : "", signature ? signature : "", signature ? "\"" : "",
+                                algo ? kSubmitAlgo : "", algo ? algo : "", algo ? "\"" : "");
+
+        if (rc > 0 && static_cast<size_t>(rc) < m_sendBuf.size()) {
+            size = static_cast<size_t>(rc);
+        }
     }
-#   endif
 
-    if (has<EXT_ALGO>() && result.algorithm.isValid()) {
-        params.AddMember("algo", StringRef(result.algorithm.name()), allocator);
+    // Generic path, also taken if the pre-formatted request did not fit
+    if (size == 0) {
+        Document doc(kObjectType);
+        auto &allocator = doc.GetAllocator();
+
+        Value params(kObjectType);
+        params.AddMember("id",     StringRef(m_rpcId.data()), allocator);
+        params.AddMember("job_id", StringRef(result.jobId.data()), allocator);
+        params.AddMember("nonce",  StringRef(nonce), allocator);
+        params.AddMember("result", StringRef(data), allocator);
+
+        if (signature) {
+            params.AddMember("sig", StringRef(signature), allocator);
+        }
+
+        if (algo) {
+            params.AddMember("algo", StringRef(algo), allocator);
+        }
+
+        JsonRequest::create(doc, m_sequence, "submit", params);
+
+        size = serialize(doc);
     }
 
-    JsonRequest::create(doc, m_sequence, "submit", params);
+    if (size == 0) {
+        return -1;
+    }
 
 #   ifdef XMRIG_PROXY_PROJECT
     m_results[m_sequence] = SubmitResult(m_sequence, result.diff, result.actualDiff(), result.id, 0);
@@ -239,7 +272,7 @@ int64_t xmrig::Client::submit(const JobResult &result)
     m_results[m_sequence] = SubmitResult(m_sequence, result.diff, result.actualDiff(), 0, result.backend);
 #   endif
 
-    return send(doc);
+    return m_pool.submitWindow() ? enqueue(size) : send(size);
 }
 
 
@@ -307,6 +340,26 @@ void xmrig::Client::tick(uint64_t now)
 }
 
 
+void xmrig::Client::onLineTooLong(size_t size)
+{
+    if (!isQuiet()) {
+        LOG_ERR("%s " RED("read error: ") RED_BOLD("\"line too long: %zu+ bytes, limit %zu\""), tag(), size, m_reader.maxSize());
+    }
+
+    close();
+}
+
+
+void xmrig::Client::onTimer(const Timer *timer)
+{
+    if (timer == m_attemptTimer) {
+        return connectNext();
+    }
+
+    flush();
+}
+
+
 void xmrig::Client::onResolved(const DnsRecords &records, int status, const char *error)
 {
     m_dns.reset();
@@ -324,10 +377,12 @@ void xmrig::Client::onResolved(const DnsRecords &records, int status, const char
         return reconnect();
     }
 
-    const auto &record = records.get();
-    m_ip = record.ip();
+    m_records = records.interleaved();
+    m_next    = 0;
+    m_ip      = m_records.front().ip();
 
-    connect(record.addr(m_socks5 ? m_pool.proxy().port() : m_pool.port()));
+    setState(ConnectingState);
+    connectNext();
 }
 
 
@@ -337,11 +392,24 @@ bool xmrig::Client::close()
         return m_socket != nullptr;
     }
 
+    // Still connecting, one of the pending attempts stands in for the socket to drive the usual close path
+    if (m_socket == nullptr && !m_attempts.empty()) {
+        m_socket = m_attempts.front().socket;
+        m_attempts.erase(m_attempts.begin());
+    }
+
     if (m_state == UnconnectedState || m_socket == nullptr) {
         return false;
     }
 
     setState(ClosingState);
+    abortAttempts();
+
+    m_batch.clear();
+
+    if (m_timer) {
+        m_timer->stop();
+    }
 
     if (uv_is_closing(reinterpret_cast<uv_handle_t*>(m_socket)) == 0) {
         if (Platform::hasKeepalive()) {
@@ -354,22 +422,22 @@ bool xmrig::Client::close()
 }
 
 
-bool xmrig::Client::parseJob(const rapidjson::Value &params, int *code)
+bool xmrig::Client::parseJob(const StratumJob &params, int *code)
 {
-    if (!params.IsObject()) {
+    if (!params.isValid) {
         *code = 2;
         return false;
     }
 
     Job job(has<EXT_NICEHASH>(), m_pool.algorithm(), m_rpcId);
 
-    if (!job.setId(Json::getString(params, "job_id"))) {
+    if (!job.setId(params.jobId)) {
         *code = 3;
         return false;
     }
 
-    const char *algo = Json::getString(params, "algo");
-    const char *blobData = Json::getString(params, "blob");
+    const char *algo = params.algo;
+    const char *blobData = params.blob;
     if (algo) {
         job.setAlgorithm(algo);
     }
@@ -383,8 +451,8 @@ bool xmrig::Client::parseJob(const rapidjson::Value &params, int *code)
 
 #   ifdef XMRIG_FEATURE_HTTP
     if (m_pool.mode() == Pool::MODE_SELF_SELECT) {
-        job.setExtraNonce(Json::getString(params, "extra_nonce"));
-        job.setPoolWallet(Json::getString(params, "pool_wallet"));
+        job.setExtraNonce(params.extraNonce);
+        job.setPoolWallet(params.poolWallet);
 
         if (job.extraNonce().isNull() || job.poolWallet().isNull()) {
             *code = 4;
@@ -400,28 +468,31 @@ bool xmrig::Client::parseJob(const rapidjson::Value &params, int *code)
         }
     }
 
-    if (!job.setTarget(Json::getString(params, "target"))) {
+    if (!job.setTarget(params.target)) {
         *code = 5;
         return false;
     }
 
-    job.setHeight(Json::getUint64(params, "height"));
+    job.setHeight(params.height);
 
     if (!verifyAlgorithm(job.algorithm(), algo)) {
         *code = 6;
         return false;
     }
 
-    if (m_pool.mode() != Pool::MODE_SELF_SELECT && job.algorithm().family() == Algorithm::RANDOM_X && !job.setSeedHash(Json::getString(params, "seed_hash"))) {
+    if (m_pool.mode() != Pool::MODE_SELF_SELECT && job.algorithm().family() == Algorithm::RANDOM_X && !job.setSeedHash(params.seedHash)) {
         *code = 7;
         return false;
     }
 
-    job.setSigKey(Json::getString(params, "sig_key"));
+    job.setSigKey(params.sigKey);
 
     m_job.setClientId(m_rpcId);
 
     if (m_job != job) {
+        job.setTrace(Job::TRACE_RECEIVED, m_received);
+        job.setTrace(Job::TRACE_PARSED, Chrono::steadyUSecs());
+
         m_jobs++;
         m_job = std::move(job);
         return true;
@@ -495,6 +566,45 @@ bool xmrig::Client::verifyAlgorithm(const Algorithm &algorithm, const char *algo
 }
 
 
+bool xmrig::Client::flush()
+{
+    if (m_batch.empty()) {
+        return true;
+    }
+
+    m_timer->stop();
+
+    LOG_DEBUG("[%s] send batch (%d bytes)", url(), static_cast<int>(m_batch.size()));
+
+    const bool rc = write(m_batch.data(), m_batch.size());
+    m_batch.clear();
+
+    // Round trip of the batched shares starts now, the time they spent in the window is not pool latency
+    for (auto it = m_results.lower_bound(m_batchSeq); it != m_results.end(); ++it) {
+        it->second.start();
+    }
+
+    return rc;
+}
+
+
+bool xmrig::Client::write(char *data, size_t size)
+{
+#   ifdef XMRIG_FEATURE_TLS
+    if (isTLS()) {
+        return m_tls->send(data, size);
+    }
+#   endif
+
+    if (state() != ConnectedState || !uv_is_writable(stream())) {
+        LOG_DEBUG_ERR("[%s] send failed, invalid state: %d", url(), m_state);
+        return false;
+    }
+
+    return write(uv_buf_init(data, static_cast<unsigned int>(size)));
+}
+
+
 bool xmrig::Client::write(const uv_buf_t &buf)
 {
     const int rc = uv_try_write(stream(), &buf, 1);
@@ -532,25 +642,40 @@ int64_t xmrig::Client::send(size_t size)
 {
     LOG_DEBUG("[%s] send (%d bytes): \"%.*s\"", url(), size, static_cast<int>(size) - 1, m_sendBuf.data());
 
-#   ifdef XMRIG_FEATURE_TLS
-    if (isTLS()) {
-        if (!m_tls->send(m_sendBuf.data(), size)) {
-            return -1;
-        }
+    // Requests must not overtake shares still waiting in the batch
+    if (!flush() || !write(m_sendBuf.data(), size)) {
+        return -1;
     }
-    else
-#   endif
-    {
-        if (state() != ConnectedState || !uv_is_writable(stream())) {
-            LOG_DEBUG_ERR("[%s] send failed, invalid state: %d", url(), m_state);
-            return -1;
-        }
 
-        uv_buf_t buf = uv_buf_init(m_sendBuf.data(), (unsigned int) size);
+    m_expire = Chrono::steadyMSecs() + kResponseTimeout;
+    return m_sequence++;
+}
+
+
+int64_t xmrig::Client::enqueue(size_t size)
+{
+    LOG_DEBUG("[%s] enqueue (%d bytes): \"%.*s\"", url(), size, static_cast<int>(size) - 1, m_sendBuf.data());
 
-        if (!write(buf)) {
-            return -1;
+    if (state() != ConnectedState) {
+        LOG_DEBUG_ERR("[%s] send failed, invalid state: %d", url(), m_state);
+        return -1;
+    }
+
+    if (m_batch.size() + size > kMaxSendBufferSize && !flush()) {
+        return -1;
+    }
+
+    m_batch.insert(m_batch.end(), m_sendBuf.data(), m_sendBuf.data() + size);
+
+    // The window starts with the first share of a batch, everything produced until it expires is sent with one write
+    if (m_batch.size() == size) {
+        m_batchSeq = m_sequence;
+
+        if (!m_timer) {
+            m_timer = new Timer(this);
         }
+
+        m_timer->singleShot(m_pool.submitWindow());
     }
 
     m_expire = Chrono::steadyMSecs() + kResponseTimeout;
@@ -558,24 +683,91 @@ int64_t xmrig::Client::send(size_t size)
 }
 
 
-void xmrig::Client::connect(const sockaddr *addr)
+size_t xmrig::Client::serialize(const rapidjson::Value &obj)
 {
-    setState(ConnectingState);
+    using namespace rapidjson;
+
+    StringBuffer buffer(nullptr, 512);
+    Writer<StringBuffer> writer(buffer);
+    obj.Accept(writer);
+
+    const size_t size = buffer.GetSize();
+    if (size > kMaxSendBufferSize) {
+        LOG_ERR("%s " RED("send failed: ") RED_BOLD("\"max send buffer size exceeded: %zu\""), tag(), size);
+        close();
+
+        return 0;
+    }
+
+    if (size > (m_sendBuf.size() - 2)) {
+        m_sendBuf.resize(((size + 1) / 1024 + 1) * 1024);
+    }
+
+    memcpy(m_sendBuf.data(), buffer.GetString(), size);
+    m_sendBuf[size]     = '\n';
+    m_sendBuf[size + 1] = '\0';
+
+    return size + 1;
+}
+
+
+void xmrig::Client::abortAttempts()
+{
+    if (m_attemptTimer) {
+        m_attemptTimer->stop();
+    }
+
+    for (const auto &attempt : m_attempts) {
+        Handle::close(attempt.socket);
+    }
 
+    m_attempts.clear();
+    m_records.clear();
+}
+
+
+void xmrig::Client::connect(const DnsRecord &record)
+{
     auto req = new uv_connect_t;
     req->data = m_storage.ptr(m_key);
 
-    m_socket = new uv_tcp_t;
-    m_socket->data = m_storage.ptr(m_key);
+    auto socket = new uv_tcp_t;
+    socket->data = m_storage.ptr(m_key);
 
-    uv_tcp_init(uv_default_loop(), m_socket);
-    uv_tcp_nodelay(m_socket, 1);
+    uv_tcp_init(uv_default_loop(), socket);
+    uv_tcp_nodelay(socket, 1);
 
     if (Platform::hasKeepalive()) {
-        uv_tcp_keepalive(m_socket, 1, 60);
+        uv_tcp_keepalive(socket, 1, 60);
     }
 
-    uv_tcp_connect(req, m_socket, addr, onConnect);
+    m_attempts.push_back({ socket, record.ip() });
+
+    const int rc = uv_tcp_connect(req, socket, record.addr(m_socks5 ? m_pool.proxy().port() : m_pool.port()), onConnect);
+    if (rc < 0) {
+        delete req;
+        onAttempt(socket, rc);
+    }
+}
+
+
+// Starts a connection to the next resolved address, each further address gets its own attempt after kAttemptDelay or
+// as soon as an earlier attempt fails, the first socket to connect wins and the rest are aborted (RFC 8305).
+void xmrig::Client::connectNext()
+{
+    if (m_state != ConnectingState || m_next >= m_records.size()) {
+        return;
+    }
+
+    connect(m_records[m_next++]);
+
+    if (m_state == ConnectingState && m_next < m_records.size()) {
+        if (!m_attemptTimer) {
+            m_attemptTimer = new Timer(this);
+        }
+
+        m_attemptTimer->singleShot(kAttemptDelay);
+    }
 }
 
 
@@ -609,7 +801,7 @@ bool xmrig::Client::parseLogin(const rapidjson::Value &result, int *code)
 
     parseExtensions(result);
 
-    const bool rc = parseJob(Json::getObject(result, "job"), code);
+    const bool rc = parseJob(StratumJob(Json::getObject(result, "job")), code);
     m_jobs = 0;
 
     return rc;
@@ -641,6 +833,43 @@ void xmrig::Client::login()
 }
 
 
+void xmrig::Client::onAttempt(uv_tcp_t *socket, int status)
+{
+    auto it = std::find_if(m_attempts.begin(), m_attempts.end(), [socket](const Attempt &attempt) { return attempt.socket == socket; });
+    if (it == m_attempts.end()) {
+        return;
+    }
+
+    if (status < 0) {
+        if (!isQuiet()) {
+            LOG_ERR("%s %s " RED("connect error: ") RED_BOLD("\"%s\""), tag(), it->ip.data(), uv_strerror(status));
+        }
+
+        // The last address failed, close as before so the usual reconnect logic applies
+        if (m_attempts.size() == 1 && m_next >= m_records.size()) {
+            close();
+            return;
+        }
+
+        Handle::close(socket);
+        m_attempts.erase(it);
+
+        return connectNext();
+    }
+
+    m_ip     = it->ip;
+    m_socket = socket;
+    m_attempts.erase(it);
+
+    abortAttempts();
+    setState(ConnectedState);
+
+    uv_read_start(stream(), NetBuffer::onAlloc, onRead);
+
+    handshake();
+}
+
+
 void xmrig::Client::onClose()
 {
     delete m_socket;
@@ -673,6 +902,22 @@ void xmrig::Client::parse(char *line, size_t len)
         return;
     }
 
+    // Fast path for new jobs and share results, without building a DOM
+    switch (hasStratumFastPath() ? m_stratum.read(line, len) : StratumReader::UNKNOWN) {
+    case StratumReader::JOB:
+        return parseJobNotification(m_stratum.job(), rapidjson::Value(rapidjson::kNullType));
+
+    case StratumReader::RESPONSE:
+        if (m_stratum.id() != 1 && m_callbacks.count(m_stratum.id()) == 0) {
+            handleSubmitResponse(m_stratum.id());
+            return;
+        }
+        break;
+
+    default:
+        break;
+    }
+
     rapidjson::Document doc;
     if (doc.ParseInsitu(line).HasParseError()) {
         if (!isQuiet()) {
@@ -792,15 +1037,19 @@ void xmrig::Client::parseExtensions(const rapidjson::Value &result)
 void xmrig::Client::parseNotification(const char *method, const rapidjson::Value &params, const rapidjson::Value &)
 {
     if (strcmp(method, "job") == 0) {
-        int code = -1;
-        if (parseJob(params, &code)) {
-            m_listener->onJobReceived(this, m_job, params);
-        }
-        else {
-            close();
-        }
+        return parseJobNotification(StratumJob(params), params);
+    }
+}
 
-        return;
+
+void xmrig::Client::parseJobNotification(const StratumJob &job, const rapidjson::Value &params)
+{
+    int code = -1;
+    if (parseJob(job, &code)) {
+        m_listener->onJobReceived(this, m_job, params);
+    }
+    else {
+        close();
     }
 }
 
@@ -864,6 +1113,8 @@ void xmrig::Client::ping()
 
 void xmrig::Client::read(ssize_t nread, const uv_buf_t *buf)
 {
+    m_received = Chrono::steadyUSecs();
+
     const auto size = static_cast<size_t>(nread);
     if (nread < 0) {
         if (!isQuiet()) {
@@ -1014,38 +1265,12 @@ void xmrig::Client::onClose(uv_handle_t *handle)
 void xmrig::Client::onConnect(uv_connect_t *req, int status)
 {
     auto client = getClient(req->data);
+    auto socket = reinterpret_cast<uv_tcp_t *>(req->handle);
     delete req;
 
-    if (!client) {
-        return;
+    if (client && client->state() == ConnectingState) {
+        client->onAttempt(socket, status);
     }
-
-    if (status < 0) {
-        if (!client->isQuiet()) {
-            LOG_ERR("%s %s " RED("connect error: ") RED_BOLD("\"%s\""), client->tag(), client->ip().data(), uv_strerror(status));
-        }
-
-        if (client->state() == ReconnectingState || client->state() == ClosingState) {
-            return;
-        }
-
-        if (client->state() != ConnectingState) {
-            return;
-        }
-
-        client->close();
-        return;
-    }
-
-    if (client->state() == ConnectedState) {
-        return;
-    }
-
-    client->setState(ConnectedState);
-
-    uv_read_start(client->stream(), NetBuffer::onAlloc, onRead);
-
-    client->handshake();
 }
 
 
@@ -29,9 +29,12 @@
 
 #include "base/kernel/interfaces/IDnsListener.h"
 #include "base/kernel/interfaces/ILineListener.h"
+#include "base/kernel/interfaces/ITimerListener.h"
+#include "base/net/dns/DnsRecord.h"
 #include "base/net/stratum/BaseClient.h"
 #include "base/net/stratum/Job.h"
 #include "base/net/stratum/Pool.h"
+#include "base/net/stratum/StratumReader.h"
 #include "base/net/stratum/SubmitResult.h"
 #include "base/net/tools/LineReader.h"
 #include "base/net/tools/Storage.h"
@@ -49,11 +52,12 @@ class IClientListener;
 class JobResult;
 
 
-class Client : public BaseClient, public IDnsListener, public ILineListener
+class Client : public BaseClient, public IDnsListener, public ILineListener, public ITimerListener
 {
 public:
     XMRIG_DISABLE_COPY_MOVE_DEFAULT(Client)
 
+    constexpr static uint64_t kAttemptDelay     = 250;
     constexpr static uint64_t kConnectTimeout   = 20 * 1000;
     constexpr static uint64_t kResponseTimeout  = 20 * 1000;
     constexpr static size_t kMaxSendBufferSize  = 1024 * 16;
@@ -74,7 +78,9 @@ protected:
     void deleteLater() override;
     void tick(uint64_t now) override;
 
+    void onLineTooLong(size_t size) override;
     void onResolved(const DnsRecords &records, int status, const char *error) override;
+    void onTimer(const Timer *timer) override;
 
     inline bool hasExtension(Extension extension) const noexcept override   { return m_extensions.test(extension); }
     inline const char *mode() const override                                { return "pool"; }
@@ -90,6 +96,9 @@ protected:
     virtual void login();
     virtual void parseNotification(const char* method, const rapidjson::Value& params, const rapidjson::Value& error);
 
+    // Clients which override the handling of "job" notifications or responses must opt out of StratumReader
+    inline virtual bool hasStratumFastPath() const                          { return true; }
+
     bool close();
     virtual void onClose();
 
@@ -97,17 +106,32 @@ private:
     class Socks5;
     class Tls;
 
-    bool parseJob(const rapidjson::Value &params, int *code);
+    // Pending connection to one of the resolved addresses
+    struct Attempt
+    {
+        uv_tcp_t *socket;
+        String ip;
+    };
+
+    bool flush();
+    bool parseJob(const StratumJob &params, int *code);
     bool send(BIO *bio);
     bool verifyAlgorithm(const Algorithm &algorithm, const char *algo) const;
+    bool write(char *data, size_t size);
     bool write(const uv_buf_t &buf);
     int resolve(const String &host);
+    int64_t enqueue(size_t size);
     int64_t send(size_t size);
-    void connect(const sockaddr *addr);
+    size_t serialize(const rapidjson::Value &obj);
+    void abortAttempts();
+    void connect(const DnsRecord &record);
+    void connectNext();
     void handshake();
     void parse(char *line, size_t len);
     void parseExtensions(const rapidjson::Value &result);
+    void parseJobNotification(const StratumJob &job, const rapidjson::Value &params);
     void parseResponse(int64_t id, const rapidjson::Value &result, const rapidjson::Value &error);
+    void onAttempt(uv_tcp_t *socket, int status);
     void ping();
     void read(ssize_t nread, const uv_buf_t *buf);
     void reconnect();
@@ -130,14 +154,23 @@ private:
     LineReader m_reader;
     Socks5 *m_socks5            = nullptr;
     std::bitset<EXT_MAX> m_extensions;
+    size_t m_next               = 0;
     std::shared_ptr<DnsRequest> m_dns;
+    std::vector<Attempt> m_attempts;
+    std::vector<char> m_batch;
+    std::vector<DnsRecord> m_records;
     std::vector<char> m_sendBuf;
     std::vector<char> m_tempBuf;
+    StratumReader m_stratum;
     String m_rpcId;
+    Timer *m_attemptTimer       = nullptr;
+    Timer *m_timer              = nullptr;
     Tls *m_tls                  = nullptr;
+    int64_t m_batchSeq          = 0;
     uint64_t m_expire           = 0;
     uint64_t m_jobs             = 0;
     uint64_t m_keepAlive        = 0;
+    uint64_t m_received         = 0;
     uintptr_t m_key             = 0;
     uv_tcp_t *m_socket          = nullptr;
 
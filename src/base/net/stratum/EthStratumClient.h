@@ -38,6 +38,8 @@ public:
     ~EthStratumClient() override = default;
 
 protected:
+    inline bool hasStratumFastPath() const override { return false; }
+
     int64_t submit(const JobResult &result) override;
     void login() override;
     void onClose() override;
@@ -245,6 +245,7 @@ void xmrig::Job::copy(const Job &other)
     m_poolWallet = other.m_poolWallet;
 
     memcpy(m_blob, other.m_blob, sizeof(m_blob));
+    memcpy(m_trace, other.m_trace, sizeof(m_trace));
 
 #   ifdef XMRIG_PROXY_PROJECT
     m_rawSeedHash = other.m_rawSeedHash;
@@ -296,6 +297,7 @@ void xmrig::Job::move(Job &&other)
     m_poolWallet = std::move(other.m_poolWallet);
 
     memcpy(m_blob, other.m_blob, sizeof(m_blob));
+    memcpy(m_trace, other.m_trace, sizeof(m_trace));
 
     other.m_size        = 0;
     other.m_diff        = 0;
@@ -48,6 +48,15 @@ public:
     static constexpr const size_t kMaxBlobSize = 408;
     static constexpr const size_t kMaxSeedSize = 32;
 
+    // Chrono::steadyUSecs() timestamps of the way from the pool socket to the workers, zero if the stage was not seen
+    enum TraceStage : uint8_t {
+        TRACE_RECEIVED,     // bytes read from the socket
+        TRACE_PARSED,       // parsed by the client
+        TRACE_DISPATCHED,   // handed over to the miner
+        TRACE_READY,        // published to the workers
+        TRACE_MAX
+    };
+
     Job() = default;
     Job(bool nicehash, const Algorithm &algorithm, const String &clientId);
 
@@ -87,6 +96,7 @@ public:
     inline uint8_t *blob()                              { return m_blob; }
     inline uint8_t fixedByte() const                    { return *(m_blob + 42); }
     inline uint8_t index() const                        { return m_index; }
+    inline uint64_t trace(TraceStage stage) const       { return m_trace[stage]; }
     inline void reset()                                 { m_size = 0; m_diff = 0; }
     inline void setAlgorithm(const Algorithm::Id id)    { m_algorithm = id; }
     inline void setAlgorithm(const char *algo)          { m_algorithm = algo; }
@@ -96,6 +106,7 @@ public:
     inline void setHeight(uint64_t height)              { m_height = height; }
     inline void setIndex(uint8_t index)                 { m_index = index; }
     inline void setPoolWallet(const String &poolWallet) { m_poolWallet = poolWallet; }
+    inline void setTrace(TraceStage stage, uint64_t ts) { m_trace[stage] = ts; }
 
 #   ifdef XMRIG_PROXY_PROJECT
     inline char *rawBlob()                              { return m_rawBlob; }
@@ -159,6 +170,7 @@ private:
     uint64_t m_diff     = 0;
     uint64_t m_height   = 0;
     uint64_t m_target   = 0;
+    uint64_t m_trace[TRACE_MAX]{};
     uint8_t m_blob[kMaxBlobSize]{ 0 };
     uint8_t m_index     = 0;
 
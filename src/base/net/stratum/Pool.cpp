@@ -76,6 +76,7 @@ const char *Pool::kRigId                  = "rig-id";
 const char *Pool::kSelfSelect             = "self-select";
 const char *Pool::kSOCKS5                 = "socks5";
 const char *Pool::kSubmitToOrigin         = "submit-to-origin";
+const char *Pool::kSubmitWindow           = "submit-window";
 const char *Pool::kTls                    = "tls";
 const char *Pool::kSni                    = "sni";
 const char *Pool::kUrl                    = "url";
@@ -129,6 +130,7 @@ xmrig::Pool::Pool(const rapidjson::Value &object) :
     m_fingerprint    = Json::getString(object, kFingerprint);
     m_pollInterval   = Json::getUint64(object, kDaemonPollInterval, kDefaultPollInterval);
     m_jobTimeout     = Json::getUint64(object, kDaemonJobTimeout, kDefaultJobTimeout);
+    m_submitWindow   = Json::getUint64(object, kSubmitWindow);
     m_algorithm      = Json::getString(object, kAlgo);
     m_coin           = Json::getString(object, kCoin);
     m_daemon         = Json::getString(object, kSelfSelect);
@@ -215,6 +217,7 @@ bool xmrig::Pool::isEqual(const Pool &other) const
             && m_user         == other.m_user
             && m_pollInterval == other.m_pollInterval
             && m_jobTimeout   == other.m_jobTimeout
+            && m_submitWindow == other.m_submitWindow
             && m_daemon       == other.m_daemon
             && m_proxy        == other.m_proxy
             );
@@ -297,6 +300,8 @@ rapidjson::Value xmrig::Pool::toJSON(rapidjson::Document &doc) const
         else {
             obj.AddMember(StringRef(kKeepalive), m_keepAlive, allocator);
         }
+
+        obj.AddMember(StringRef(kSubmitWindow), m_submitWindow, allocator);
     }
 
     obj.AddMember(StringRef(kEnabled),      m_flags.test(FLAG_ENABLED), allocator);
@@ -354,6 +359,7 @@ void xmrig::Pool::print() const
     LOG_DEBUG ("algo:      %s", m_algorithm.name());
     LOG_DEBUG ("nicehash:  %d", static_cast<int>(m_flags.test(FLAG_NICEHASH)));
     LOG_DEBUG ("keepAlive: %d", m_keepAlive);
+    LOG_DEBUG ("submitWindow: %d", static_cast<int>(m_submitWindow));
 }
 #endif
 
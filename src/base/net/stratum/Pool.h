@@ -69,6 +69,7 @@ public:
     static const char *kSelfSelect;
     static const char *kSOCKS5;
     static const char *kSubmitToOrigin;
+    static const char *kSubmitWindow;
     static const char *kTls;
     static const char *kSni;
     static const char *kUrl;
@@ -115,6 +116,7 @@ public:
     inline int zmq_port() const                         { return m_zmqPort; }
     inline uint64_t pollInterval() const                { return m_pollInterval; }
     inline uint64_t jobTimeout() const                  { return m_jobTimeout; }
+    inline uint64_t submitWindow() const                { return m_submitWindow; }
     inline void setAlgo(const Algorithm &algorithm)     { m_algorithm = algorithm; }
     inline void setUrl(const char *url)                 { m_url = Url(url); }
     inline void setPassword(const String &password)     { m_password = password; }
@@ -163,6 +165,7 @@ private:
     String m_spendSecretKey;
     uint64_t m_pollInterval         = kDefaultPollInterval;
     uint64_t m_jobTimeout           = kDefaultJobTimeout;
+    uint64_t m_submitWindow         = 0;
     Url m_daemon;
     Url m_url;
     int m_zmqPort                   = -1;
@@ -28,15 +28,24 @@
 #include "base/io/log/Log.h"
 #include "base/kernel/interfaces/IJsonReader.h"
 #include "base/net/stratum/strategies/FailoverStrategy.h"
+#include "base/net/stratum/strategies/LatencyStrategy.h"
 #include "base/net/stratum/strategies/SinglePoolStrategy.h"
 #include "donate.h"
 
 
+#include <cstring>
+
+
 #ifdef XMRIG_FEATURE_BENCHMARK
 #   include "base/net/stratum/benchmark/BenchConfig.h"
 #endif
 
 
+#ifdef _MSC_VER
+#   define strcasecmp  _stricmp
+#endif
+
+
 namespace xmrig {
 
 
@@ -45,6 +54,11 @@ const char *Pools::kDonateOverProxy = "donate-over-proxy";
 const char *Pools::kPools           = "pools";
 const char *Pools::kRetries         = "retries";
 const char *Pools::kRetryPause      = "retry-pause";
+const char *Pools::kStandby         = "pool-standby";
+const char *Pools::kStrategy        = "pool-strategy";
+
+
+static const char *strategyNames[] = { "failover", "latency" };
 
 
 } // namespace xmrig
@@ -62,7 +76,7 @@ xmrig::Pools::Pools() :
 
 bool xmrig::Pools::isEqual(const Pools &other) const
 {
-    if (m_data.size() != other.m_data.size() || m_retries != other.m_retries || m_retryPause != other.m_retryPause) {
+    if (m_data.size() != other.m_data.size() || m_retries != other.m_retries || m_retryPause != other.m_retryPause || m_standby != other.m_standby || m_strategy != other.m_strategy) {
         return false;
     }
 
@@ -90,7 +104,19 @@ xmrig::IStrategy *xmrig::Pools::createStrategy(IStrategyListener *listener) cons
         }
     }
 
+    if (m_strategy == STRATEGY_LATENCY) {
+        auto strategy = new LatencyStrategy(retryPause(), retries(), listener);
+        for (const Pool &pool : m_data) {
+            if (pool.isEnabled()) {
+                strategy->add(pool);
+            }
+        }
+
+        return strategy;
+    }
+
     auto strategy = new FailoverStrategy(retryPause(), retries(), listener);
+    strategy->setStandby(static_cast<size_t>(standby()));
     for (const Pool &pool : m_data) {
         if (pool.isEnabled()) {
             strategy->add(pool);
@@ -162,6 +188,8 @@ void xmrig::Pools::load(const IJsonReader &reader)
     setProxyDonate(reader.getInt(kDonateOverProxy, PROXY_DONATE_AUTO));
     setRetries(reader.getInt(kRetries));
     setRetryPause(reader.getInt(kRetryPause));
+    setStandby(reader.getInt(kStandby));
+    setStrategy(reader.getString(kStrategy));
 }
 
 
@@ -212,6 +240,8 @@ void xmrig::Pools::toJSON(rapidjson::Value &out, rapidjson::Document &doc) const
     out.AddMember(StringRef(kPools),            toJSON(doc), allocator);
     doc.AddMember(StringRef(kRetries),          retries(), allocator);
     doc.AddMember(StringRef(kRetryPause),       retryPause(), allocator);
+    doc.AddMember(StringRef(kStandby),          standby(), allocator);
+    doc.AddMember(StringRef(kStrategy),         StringRef(strategyNames[m_strategy]), allocator);
 }
 
 
@@ -251,3 +281,27 @@ void xmrig::Pools::setRetryPause(int retryPause)
         m_retryPause = retryPause;
     }
 }
+
+
+void xmrig::Pools::setStandby(int standby)
+{
+    if (standby >= 0 && standby <= 16) {
+        m_standby = standby;
+    }
+}
+
+
+void xmrig::Pools::setStrategy(const char *strategy)
+{
+    if (!strategy) {
+        return;
+    }
+
+    for (size_t i = 0; i < sizeof(strategyNames) / sizeof(strategyNames[0]); ++i) {
+        if (strcasecmp(strategy, strategyNames[i]) == 0) {
+            m_strategy = static_cast<Strategy>(i);
+
+            return;
+        }
+    }
+}
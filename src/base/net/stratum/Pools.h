@@ -48,6 +48,8 @@ public:
     static const char *kPools;
     static const char *kRetries;
     static const char *kRetryPause;
+    static const char *kStandby;
+    static const char *kStrategy;
 
     enum ProxyDonate {
         PROXY_DONATE_NONE,
@@ -55,6 +57,11 @@ public:
         PROXY_DONATE_ALWAYS
     };
 
+    enum Strategy {
+        STRATEGY_FAILOVER,
+        STRATEGY_LATENCY
+    };
+
     Pools();
 
 #   ifdef XMRIG_FEATURE_BENCHMARK
@@ -66,7 +73,9 @@ public:
     inline const std::vector<Pool> &data() const        { return m_data; }
     inline int retries() const                          { return m_retries; }
     inline int retryPause() const                       { return m_retryPause; }
+    inline int standby() const                          { return m_standby; }
     inline ProxyDonate proxyDonate() const              { return m_proxyDonate; }
+    inline Strategy strategy() const                    { return m_strategy; }
 
     inline bool operator!=(const Pools &other) const    { return !isEqual(other); }
     inline bool operator==(const Pools &other) const    { return isEqual(other); }
@@ -86,11 +95,15 @@ private:
     void setProxyDonate(int value);
     void setRetries(int retries);
     void setRetryPause(int retryPause);
+    void setStandby(int standby);
+    void setStrategy(const char *strategy);
 
     int m_donateLevel;
     int m_retries               = 5;
     int m_retryPause            = 5;
+    int m_standby               = 0;
     ProxyDonate m_proxyDonate   = PROXY_DONATE_AUTO;
+    Strategy m_strategy         = STRATEGY_FAILOVER;
     std::vector<Pool> m_data;
 
 #   ifdef XMRIG_FEATURE_BENCHMARK
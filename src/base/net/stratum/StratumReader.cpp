@@ -0,0 +1,289 @@
+/* XMRig
+ * Copyright (c) 2018-2023 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2023 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "base/net/stratum/StratumReader.h"
+#include "3rdparty/rapidjson/document.h"
+#include "base/io/json/Json.h"
+
+
+#include <cstring>
+#include <limits>
+
+
+namespace xmrig {
+
+
+static const struct {
+    const char *key;
+    const char *StratumJob::*field;
+} kJobFields[] = {
+    { "algo",           &StratumJob::algo },
+    { "blob",           &StratumJob::blob },
+    { "extra_nonce",    &StratumJob::extraNonce },
+    { "job_id",         &StratumJob::jobId },
+    { "pool_wallet",    &StratumJob::poolWallet },
+    { "seed_hash",      &StratumJob::seedHash },
+    { "sig_key",        &StratumJob::sigKey },
+    { "target",         &StratumJob::target },
+};
+
+
+static constexpr size_t kJobFieldsCount = sizeof(kJobFields) / sizeof(kJobFields[0]);
+static constexpr size_t kHeightField    = kJobFieldsCount;
+static constexpr size_t kNoField        = kJobFieldsCount + 1;
+
+
+class StratumReader::Handler
+{
+public:
+    inline explicit Handler(StratumJob &job) : m_job(job) {}
+
+    inline bool Null()                                  { return value(NULL_VALUE); }
+    inline bool Bool(bool)                              { return value(OTHER_VALUE); }
+    inline bool Int(int i)                              { return value(INT_VALUE, nullptr, static_cast<uint64_t>(static_cast<int64_t>(i))); }
+    inline bool Uint(unsigned u)                        { return value(UINT_VALUE, nullptr, u); }
+    inline bool Int64(int64_t i)                        { return value(INT_VALUE, nullptr, static_cast<uint64_t>(i)); }
+    inline bool Uint64(uint64_t u)                      { return value(UINT_VALUE, nullptr, u); }
+    inline bool Double(double)                          { return value(OTHER_VALUE); }
+    inline bool RawNumber(const char *, size_t, bool)   { return value(OTHER_VALUE); }
+    inline bool String(const char *str, size_t, bool)   { return value(STRING_VALUE, str); }
+    inline bool StartObject()                           { return start(false); }
+    inline bool EndObject(size_t)                       { --m_depth; return true; }
+    inline bool StartArray()                            { return start(true); }
+    inline bool EndArray(size_t)                        { --m_depth; return true; }
+
+    bool Key(const char *str, size_t, bool)
+    {
+        if (m_depth == 1) {
+            m_key = KEY_OTHER;
+
+            if      (strcmp(str, "id") == 0)        { m_key = KEY_ID; }
+            else if (strcmp(str, "method") == 0)    { m_key = KEY_METHOD; }
+            else if (strcmp(str, "error") == 0)     { m_key = KEY_ERROR; }
+            else if (strcmp(str, "result") == 0)    { m_key = KEY_RESULT; }
+            else if (strcmp(str, "params") == 0)    { m_key = KEY_PARAMS; }
+
+            // The DOM path uses the first of duplicate members, just leave such messages to it
+            if (m_key != KEY_OTHER && (m_seenKeys & (1U << m_key))) {
+                return false;
+            }
+
+            m_seenKeys |= 1U << m_key;
+            return true;
+        }
+
+        if (m_depth == 2 && m_key == KEY_PARAMS) {
+            m_field = kNoField;
+
+            for (size_t i = 0; i < kJobFieldsCount; ++i) {
+                if (strcmp(str, kJobFields[i].key) == 0) {
+                    m_field = i;
+                    break;
+                }
+            }
+
+            if (m_field == kNoField && strcmp(str, "height") == 0) {
+                m_field = kHeightField;
+            }
+
+            return true;
+        }
+
+        if (m_depth == 2 && m_key == KEY_RESULT) {
+            return strcmp(str, "status") == 0;
+        }
+
+        return true;
+    }
+
+    StratumReader::Type type(int64_t &id) const
+    {
+        if (m_method) {
+            return (!m_hasId && (m_seenKeys & (1U << KEY_PARAMS))) ? JOB : UNKNOWN;
+        }
+
+        if (m_hasId && (m_seenKeys & (1U << KEY_RESULT))) {
+            id = m_id;
+
+            return RESPONSE;
+        }
+
+        return UNKNOWN;
+    }
+
+private:
+    enum Member : uint32_t {
+        KEY_OTHER,
+        KEY_ID,
+        KEY_METHOD,
+        KEY_ERROR,
+        KEY_RESULT,
+        KEY_PARAMS
+    };
+
+    enum Kind {
+        NULL_VALUE,
+        STRING_VALUE,
+        INT_VALUE,
+        UINT_VALUE,
+        OTHER_VALUE
+    };
+
+    bool start(bool array)
+    {
+        ++m_depth;
+
+        if (m_depth == 1) {
+            return !array;
+        }
+
+        if (m_depth == 2) {
+            switch (m_key) {
+            case KEY_OTHER:
+                return true;
+
+            case KEY_PARAMS:
+            case KEY_RESULT:
+                return !array;
+
+            default:
+                return false;
+            }
+        }
+
+        return m_key == KEY_PARAMS || m_key == KEY_OTHER;
+    }
+
+    bool value(Kind kind, const char *str = nullptr, uint64_t u = 0)
+    {
+        if (m_depth == 1) {
+            switch (m_key) {
+            case KEY_OTHER:
+                return true;
+
+            case KEY_ID:
+                if (kind == NULL_VALUE) {
+                    return true;
+                }
+
+                if ((kind == UINT_VALUE && u <= static_cast<uint64_t>(std::numeric_limits<int64_t>::max())) || kind == INT_VALUE) {
+                    m_id    = static_cast<int64_t>(u);
+                    m_hasId = true;
+
+                    return true;
+                }
+
+                return false;
+
+            case KEY_METHOD:
+                m_method = (kind == STRING_VALUE) && (strcmp(str, "job") == 0);
+                return m_method;
+
+            case KEY_ERROR:
+                return kind == NULL_VALUE;
+
+            default:
+                return false;
+            }
+        }
+
+        if (m_depth == 2 && m_key == KEY_PARAMS && m_field < kNoField) {
+            if (!(m_seenFields & (1U << m_field))) {
+                m_seenFields |= 1U << m_field;
+
+                if (m_field == kHeightField) {
+                    m_job.height = (kind == UINT_VALUE) ? u : 0;
+                }
+                else if (kind == STRING_VALUE) {
+                    m_job.*kJobFields[m_field].field = str;
+                }
+            }
+
+            return true;
+        }
+
+        if (m_depth == 2 && m_key == KEY_RESULT) {
+            return kind == STRING_VALUE;
+        }
+
+        return m_depth > 1;
+    }
+
+    bool m_hasId            = false;
+    bool m_method           = false;
+    int64_t m_id            = 0;
+    Member m_key            = KEY_OTHER;
+    size_t m_field          = kNoField;
+    StratumJob &m_job;
+    uint32_t m_depth        = 0;
+    uint32_t m_seenFields   = 0;
+    uint32_t m_seenKeys     = 0;
+};
+
+
+} // namespace xmrig
+
+
+xmrig::StratumJob::StratumJob(const rapidjson::Value &params) :
+    isValid(params.IsObject()),
+    algo(Json::getString(params, "algo")),
+    blob(Json::getString(params, "blob")),
+    extraNonce(Json::getString(params, "extra_nonce")),
+    jobId(Json::getString(params, "job_id")),
+    poolWallet(Json::getString(params, "pool_wallet")),
+    seedHash(Json::getString(params, "seed_hash")),
+    sigKey(Json::getString(params, "sig_key")),
+    target(Json::getString(params, "target")),
+    height(Json::getUint64(params, "height"))
+{
+}
+
+
+xmrig::StratumReader::StratumReader() :
+    m_reader(new rapidjson::Reader())
+{
+}
+
+
+xmrig::StratumReader::~StratumReader()
+{
+    delete m_reader;
+}
+
+
+xmrig::StratumReader::Type xmrig::StratumReader::read(const char *line, size_t len)
+{
+    m_buf.assign(line, line + len);
+    m_buf.push_back('\0');
+
+    m_job = StratumJob();
+    m_id  = 0;
+
+    Handler handler(m_job);
+    rapidjson::InsituStringStream stream(m_buf.data());
+
+    if (m_reader->Parse<rapidjson::kParseInsituFlag>(stream, handler).IsError()) {
+        return UNKNOWN;
+    }
+
+    const Type type = handler.type(m_id);
+    m_job.isValid   = (type == JOB);
+
+    return type;
+}
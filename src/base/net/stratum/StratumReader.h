@@ -0,0 +1,91 @@
+/* XMRig
+ * Copyright (c) 2018-2023 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2023 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_STRATUMREADER_H
+#define XMRIG_STRATUMREADER_H
+
+
+#include "3rdparty/rapidjson/fwd.h"
+#include "base/tools/Object.h"
+
+
+#include <cstdint>
+#include <vector>
+
+
+namespace xmrig {
+
+
+// Fields of a job notification, taken either from a parsed "params" object or straight from the wire by StratumReader.
+// The strings are owned by the source and are only valid until the next message.
+class StratumJob
+{
+public:
+    StratumJob() = default;
+    explicit StratumJob(const rapidjson::Value &params);
+
+    bool isValid            = false;
+    const char *algo        = nullptr;
+    const char *blob        = nullptr;
+    const char *extraNonce  = nullptr;
+    const char *jobId       = nullptr;
+    const char *poolWallet  = nullptr;
+    const char *seedHash    = nullptr;
+    const char *sigKey      = nullptr;
+    const char *target      = nullptr;
+    uint64_t height         = 0;
+};
+
+
+// Schema specific SAX reader for the two messages that matter for latency: "job" notifications and plain responses
+// ({"id":N,"error":null,"result":{"status":"..."}}). Nothing is allocated per message, the line is copied into a reusable
+// buffer and parsed in place. Any other message, or anything unexpected in these two, gives UNKNOWN and the caller should
+// fall back to the generic DOM path, the original line is left untouched for that.
+class StratumReader
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE(StratumReader)
+
+    enum Type {
+        UNKNOWN,
+        JOB,
+        RESPONSE
+    };
+
+    StratumReader();
+    ~StratumReader();
+
+    Type read(const char *line, size_t len);
+
+    inline const StratumJob &job() const    { return m_job; }
+    inline int64_t id() const               { return m_id; }
+
+private:
+    class Handler;
+
+    int64_t m_id = 0;
+    rapidjson::Reader *m_reader;
+    StratumJob m_job;
+    std::vector<char> m_buf;
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_STRATUMREADER_H */
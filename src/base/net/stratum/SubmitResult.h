@@ -46,6 +46,7 @@ public:
         m_start(Chrono::steadyMSecs())
     {}
 
+    inline void start() { m_start = Chrono::steadyMSecs(); }
     inline void done() { elapsed = Chrono::steadyMSecs() - m_start; }
 
     int64_t reqId           = 0;
@@ -19,7 +19,9 @@
 
 #include "base/net/stratum/Tls.h"
 #include "base/io/log/Log.h"
+#include "base/kernel/constants.h"
 #include "base/net/stratum/Client.h"
+#include "base/net/tools/NetBuffer.h"
 #include "base/tools/Cvt.h"
 
 
@@ -29,32 +31,37 @@
 
 
 #include <cassert>
+#include <map>
 #include <openssl/ssl.h>
 
 
+namespace xmrig {
+
+
+// Last session (ticket) received from every pool host, so a reconnect, e.g. after a pool restart, resumes instead of a full handshake
+static std::map<std::string, SSL_SESSION *> sessions;
+
+
+} // namespace xmrig
+
+
 xmrig::Client::Tls::Tls(Client *client) :
     m_client(client)
 {
-    m_ctx = SSL_CTX_new(SSLv23_method());
-    assert(m_ctx != nullptr);
-
-    if (!m_ctx) {
-        return;
-    }
-
     m_write = BIO_new(BIO_s_mem());
     m_read  = BIO_new(BIO_s_mem());
-    SSL_CTX_set_options(m_ctx, SSL_OP_NO_SSLv2 | SSL_OP_NO_SSLv3);
 }
 
 
 xmrig::Client::Tls::~Tls()
 {
-    if (m_ctx) {
-        SSL_CTX_free(m_ctx);
-    }
-
     if (m_ssl) {
+        // Pools are usually restarted or dropped without close_notify, OpenSSL would then mark the cached session as not
+        // resumable and the whole point of the cache is fast reconnects after exactly that.
+        if (m_ready) {
+            SSL_set_shutdown(m_ssl, SSL_SENT_SHUTDOWN | SSL_RECEIVED_SHUTDOWN);
+        }
+
         SSL_free(m_ssl);
     }
 }
@@ -62,7 +69,12 @@ xmrig::Client::Tls::~Tls()
 
 bool xmrig::Client::Tls::handshake(const char* servername)
 {
-    m_ssl = SSL_new(m_ctx);
+    SSL_CTX *ctx = context();
+    if (!ctx) {
+        return false;
+    }
+
+    m_ssl = SSL_new(ctx);
     assert(m_ssl != nullptr);
 
     if (!m_ssl) {
@@ -73,6 +85,14 @@ bool xmrig::Client::Tls::handshake(const char* servername)
         SSL_set_tlsext_host_name(m_ssl, servername);
     }
 
+    SSL_set_app_data(m_ssl, this);
+    m_session = std::string(m_client->m_pool.host().data()) + ":" + std::to_string(m_client->m_pool.port());
+
+    const auto it = sessions.find(m_session);
+    if (it != sessions.end()) {
+        SSL_set_session(m_ssl, it->second);
+    }
+
     SSL_set_connect_state(m_ssl);
     SSL_set_bio(m_ssl, m_read, m_write);
     SSL_do_handshake(m_ssl);
@@ -114,6 +134,13 @@ void xmrig::Client::Tls::read(const char *data, size_t size)
             X509 *cert = SSL_get_peer_certificate(m_ssl);
             if (!verify(cert)) {
                 X509_free(cert);
+
+                const auto it = sessions.find(m_session);
+                if (it != sessions.end()) {
+                    SSL_SESSION_free(it->second);
+                    sessions.erase(it);
+                }
+
                 m_client->close();
 
                 return;
@@ -127,12 +154,15 @@ void xmrig::Client::Tls::read(const char *data, size_t size)
       return;
     }
 
-    static char buf[16384]{};
+    // Decrypt into a pooled network buffer owned by this call, lines are handed out of it in place by LineReader
+    char *buf      = NetBuffer::allocate();
     int bytes_read = 0;
 
-    while ((bytes_read = SSL_read(m_ssl, buf, sizeof(buf))) > 0) {
+    while ((bytes_read = SSL_read(m_ssl, buf, static_cast<int>(XMRIG_NET_BUFFER_CHUNK_SIZE))) > 0) {
         m_client->m_reader.parse(buf, static_cast<size_t>(bytes_read));
     }
+
+    NetBuffer::release(buf);
 }
 
 
@@ -166,6 +196,45 @@ bool xmrig::Client::Tls::verify(X509 *cert)
 }
 
 
+int xmrig::Client::Tls::onNewSession(SSL *ssl, SSL_SESSION *session)
+{
+    const auto tls = static_cast<Tls *>(SSL_get_app_data(ssl));
+    if (!tls || tls->m_session.empty()) {
+        return 0;
+    }
+
+    SSL_SESSION *&cached = sessions[tls->m_session];
+    if (cached) {
+        SSL_SESSION_free(cached);
+    }
+
+    cached = session;
+
+    return 1;
+}
+
+
+SSL_CTX *xmrig::Client::Tls::context()
+{
+    static SSL_CTX *ctx = nullptr;
+
+    if (!ctx) {
+        ctx = SSL_CTX_new(SSLv23_method());
+        assert(ctx != nullptr);
+
+        if (!ctx) {
+            return nullptr;
+        }
+
+        SSL_CTX_set_options(ctx, SSL_OP_NO_SSLv2 | SSL_OP_NO_SSLv3);
+        SSL_CTX_set_session_cache_mode(ctx, SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+        SSL_CTX_sess_set_new_cb(ctx, onNewSession);
+    }
+
+    return ctx;
+}
+
+
 bool xmrig::Client::Tls::verifyFingerprint(X509 *cert)
 {
     const EVP_MD *digest = EVP_get_digestbyname("sha256");
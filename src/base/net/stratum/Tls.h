@@ -24,6 +24,7 @@
 using BIO       = struct bio_st;
 using SSL       = struct ssl_st;
 using SSL_CTX   = struct ssl_ctx_st;
+using SSL_SESSION = struct ssl_session_st;
 using X509      = struct x509_st;
 
 
@@ -31,6 +32,9 @@ using X509      = struct x509_st;
 #include "base/tools/Object.h"
 
 
+#include <string>
+
+
 namespace xmrig {
 
 
@@ -53,13 +57,16 @@ private:
     bool verify(X509 *cert);
     bool verifyFingerprint(X509 *cert);
 
+    static int onNewSession(SSL *ssl, SSL_SESSION *session);
+    static SSL_CTX *context();
+
     BIO *m_read     = nullptr;
     BIO *m_write    = nullptr;
     bool m_ready    = false;
     char m_fingerprint[32 * 2 + 8]{};
     Client *m_client;
     SSL *m_ssl      = nullptr;
-    SSL_CTX *m_ctx;
+    std::string m_session;
 };
 
 
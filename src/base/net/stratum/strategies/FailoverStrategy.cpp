@@ -22,6 +22,10 @@
 #include "base/kernel/interfaces/IClient.h"
 #include "base/kernel/interfaces/IStrategyListener.h"
 #include "base/kernel/Platform.h"
+#include "base/net/stratum/Job.h"
+#include "base/net/stratum/SubmitResult.h"
+#include "base/net/stratum/strategies/PoolRtt.h"
+#include "base/tools/Chrono.h"
 
 
 xmrig::FailoverStrategy::FailoverStrategy(const std::vector<Pool> &pools, int retryPause, int retries, IStrategyListener *listener, bool quiet) :
@@ -62,6 +66,7 @@ void xmrig::FailoverStrategy::add(const Pool &pool)
     client->setQuiet(m_quiet);
 
     m_pools.push_back(client);
+    m_states.emplace_back();
 }
 
 
@@ -77,7 +82,8 @@ int64_t xmrig::FailoverStrategy::submit(const JobResult &result)
 
 void xmrig::FailoverStrategy::connect()
 {
-    m_pools[m_index]->connect();
+    connect(m_index);
+    warmUp();
 }
 
 
@@ -113,6 +119,11 @@ void xmrig::FailoverStrategy::stop()
         pool->disconnect();
     }
 
+    for (auto &state : m_states) {
+        state.ready = false;
+        state.warm  = false;
+    }
+
     m_index  = 0;
     m_active = -1;
 
@@ -134,8 +145,16 @@ void xmrig::FailoverStrategy::onClose(IClient *client, int failures)
         return;
     }
 
+    const auto id = static_cast<size_t>(client->id());
+    m_states[id].ready = false;
+
     if (m_active == client->id()) {
         m_active = -1;
+
+        if (promote(id)) {
+            return;
+        }
+
         m_listener->onPause(this);
     }
 
@@ -143,14 +162,20 @@ void xmrig::FailoverStrategy::onClose(IClient *client, int failures)
         return;
     }
 
-    if (m_index == static_cast<size_t>(client->id()) && (m_pools.size() - m_index) > 1) {
-        m_pools[++m_index]->connect();
+    if (m_index == id && (m_pools.size() - m_index) > 1) {
+        if (!m_states[++m_index].warm) {
+            connect(m_index);
+        }
+
+        warmUp();
     }
 }
 
 
 void xmrig::FailoverStrategy::onLogin(IClient *client, rapidjson::Document &doc, rapidjson::Value &params)
 {
+    m_states[static_cast<size_t>(client->id())].login = Chrono::steadyMSecs();
+
     m_listener->onLogin(this, client, doc, params);
 }
 
@@ -165,27 +190,31 @@ void xmrig::FailoverStrategy::onJobReceived(IClient *client, const Job &job, con
 
 void xmrig::FailoverStrategy::onLoginSuccess(IClient *client)
 {
+    State &state = m_states[static_cast<size_t>(client->id())];
+    state.ready  = true;
+    PoolRtt::sample(state.rtt, Chrono::steadyMSecs() - state.login);
+
     int active = m_active;
 
     if (client->id() == 0 || !isActive()) {
         active = client->id();
     }
 
-    for (size_t i = 1; i < m_pools.size(); ++i) {
-        if (active != static_cast<int>(i)) {
-            m_pools[i]->disconnect();
-        }
-    }
+    disconnectUnused(static_cast<size_t>(active));
 
     if (active >= 0 && active != m_active) {
         m_index = m_active = active;
         m_listener->onActive(this, client);
     }
+
+    warmUp();
 }
 
 
 void xmrig::FailoverStrategy::onResultAccepted(IClient *client, const SubmitResult &result, const char *error)
 {
+    PoolRtt::sample(m_states[static_cast<size_t>(client->id())].rtt, result, error);
+
     m_listener->onResultAccepted(this, client, result, error);
 }
 
@@ -194,3 +223,78 @@ void xmrig::FailoverStrategy::onVerifyAlgorithm(const IClient *client, const Alg
 {
     m_listener->onVerifyAlgorithm(this, client, algorithm, ok);
 }
+
+
+bool xmrig::FailoverStrategy::isStandby(size_t index, size_t current) const
+{
+    return index > current && index <= current + m_standby;
+}
+
+
+bool xmrig::FailoverStrategy::promote(size_t closed)
+{
+    if (m_standby == 0) {
+        return false;
+    }
+
+    // The standby with the lowest round-trip time (login and share results) takes over, list order breaks ties
+    size_t best = m_pools.size();
+
+    for (size_t i = 0; i < m_pools.size(); ++i) {
+        if (i == closed || !m_states[i].ready || !m_pools[i]->job().isValid()) {
+            continue;
+        }
+
+        if (best == m_pools.size() || m_states[i].rtt < m_states[best].rtt) {
+            best = i;
+        }
+    }
+
+    if (best == m_pools.size()) {
+        return false;
+    }
+
+    IClient *client = m_pools[best];
+    m_index = best;
+    m_active = static_cast<int>(best);
+
+    // Pools skipped over (or left behind) by the promotion are no longer standbys of the new index
+    disconnectUnused(best);
+
+    m_listener->onActive(this, client);
+    m_listener->onJob(this, client, client->job(), rapidjson::Value(rapidjson::kNullType));
+
+    warmUp();
+
+    return true;
+}
+
+
+void xmrig::FailoverStrategy::connect(size_t index)
+{
+    m_states[index].warm = true;
+    m_pools[index]->connect();
+}
+
+
+// The primary pool keeps reconnecting on its own, every other pool is kept only as the active one or its standby.
+void xmrig::FailoverStrategy::disconnectUnused(size_t active)
+{
+    for (size_t i = 1; i < m_pools.size(); ++i) {
+        if (i != active && !isStandby(i, active)) {
+            m_pools[i]->disconnect();
+            m_states[i].ready = false;
+            m_states[i].warm  = false;
+        }
+    }
+}
+
+
+void xmrig::FailoverStrategy::warmUp()
+{
+    for (size_t i = m_index + 1; i < m_pools.size() && isStandby(i, m_index); ++i) {
+        if (!m_states[i].warm) {
+            connect(i);
+        }
+    }
+}
@@ -45,6 +45,8 @@ public:
     FailoverStrategy(int retryPause, int retries, IStrategyListener *listener, bool quiet = false);
     ~FailoverStrategy() override;
 
+    inline void setStandby(size_t standby)          { m_standby = standby; }
+
     void add(const Pool &pool);
 
 protected:
@@ -67,15 +69,32 @@ protected:
     void onVerifyAlgorithm(const IClient *client, const Algorithm &algorithm, bool *ok) override;
 
 private:
+    // Per pool state, used only in the hot standby mode
+    struct State
+    {
+        bool ready          = false;
+        bool warm           = false;
+        uint64_t login      = 0;
+        uint64_t rtt        = 0;
+    };
+
     inline IClient *active() const { return m_pools[static_cast<size_t>(m_active)]; }
 
+    bool isStandby(size_t index, size_t current) const;
+    bool promote(size_t closed);
+    void connect(size_t index);
+    void disconnectUnused(size_t active);
+    void warmUp();
+
     const bool m_quiet;
     const int m_retries;
     const int m_retryPause;
     int m_active            = -1;
     IStrategyListener *m_listener;
     size_t m_index          = 0;
+    size_t m_standby        = 0;
     std::vector<IClient*> m_pools;
+    std::vector<State> m_states;
 };
 
 
@@ -0,0 +1,308 @@
+/* XMRig
+ * Copyright (c) 2018-2020 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2020 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <algorithm>
+#include <cinttypes>
+
+
+#include "base/net/stratum/strategies/LatencyStrategy.h"
+#include "3rdparty/rapidjson/document.h"
+#include "base/io/log/Log.h"
+#include "base/io/log/Tags.h"
+#include "base/kernel/interfaces/IClient.h"
+#include "base/kernel/interfaces/IStrategyListener.h"
+#include "base/net/stratum/Job.h"
+#include "base/net/stratum/SubmitResult.h"
+#include "base/net/stratum/strategies/PoolRtt.h"
+#include "base/tools/Chrono.h"
+
+
+namespace xmrig {
+
+
+static constexpr size_t kMaxArrivals    = 16;
+static constexpr uint32_t kMinSamples   = 3;
+static constexpr uint64_t kMaxDelay     = 10000;
+static constexpr uint64_t kMinDwell     = 60000;
+static constexpr uint64_t kMinGain      = 10;
+
+
+} // namespace xmrig
+
+
+xmrig::LatencyStrategy::LatencyStrategy(int retryPause, int retries, IStrategyListener *listener, bool quiet) :
+    m_quiet(quiet),
+    m_retries(retries),
+    m_retryPause(retryPause),
+    m_listener(listener)
+{
+}
+
+
+xmrig::LatencyStrategy::~LatencyStrategy()
+{
+    for (IClient *client : m_pools) {
+        client->deleteLater();
+    }
+}
+
+
+void xmrig::LatencyStrategy::add(const Pool &pool)
+{
+    IClient *client = pool.createClient(static_cast<int>(m_pools.size()), this);
+
+    client->setRetries(m_retries);
+    client->setRetryPause(m_retryPause * 1000);
+    client->setQuiet(m_quiet);
+
+    m_pools.push_back(client);
+    m_states.emplace_back();
+}
+
+
+int64_t xmrig::LatencyStrategy::submit(const JobResult &result)
+{
+    if (!isActive()) {
+        return -1;
+    }
+
+    return active()->submit(result);
+}
+
+
+void xmrig::LatencyStrategy::connect()
+{
+    for (IClient *client : m_pools) {
+        client->connect();
+    }
+}
+
+
+void xmrig::LatencyStrategy::resume()
+{
+    if (!isActive()) {
+        return;
+    }
+
+    m_listener->onJob(this, active(), active()->job(), rapidjson::Value(rapidjson::kNullType));
+}
+
+
+void xmrig::LatencyStrategy::setAlgo(const Algorithm &algo)
+{
+    for (IClient *client : m_pools) {
+        client->setAlgo(algo);
+    }
+}
+
+
+void xmrig::LatencyStrategy::setProxy(const ProxyUrl &proxy)
+{
+    for (IClient *client : m_pools) {
+        client->setProxy(proxy);
+    }
+}
+
+
+void xmrig::LatencyStrategy::stop()
+{
+    for (auto &pool : m_pools) {
+        pool->disconnect();
+    }
+
+    for (auto &state : m_states) {
+        state = State();
+    }
+
+    m_active = -1;
+    m_arrivals.clear();
+
+    m_listener->onPause(this);
+}
+
+
+void xmrig::LatencyStrategy::tick(uint64_t now)
+{
+    for (IClient *client : m_pools) {
+        client->tick(now);
+    }
+
+    if (!isActive() || (now - m_switched) < kMinDwell) {
+        return;
+    }
+
+    const int index = best(true);
+    if (index < 0 || index == m_active) {
+        return;
+    }
+
+    const uint64_t current   = m_states[static_cast<size_t>(m_active)].latency();
+    const uint64_t candidate = m_states[static_cast<size_t>(index)].latency();
+
+    if (candidate + std::max(kMinGain, current / 5) > current) {
+        return;
+    }
+
+    if (!m_quiet) {
+        LOG_INFO("%s " WHITE_BOLD("switching to ") CYAN_BOLD("%s:%d") " latency " WHITE_BOLD("%" PRIu64 " ms") " vs " WHITE_BOLD("%" PRIu64 " ms"),
+                 Tags::network(), m_pools[static_cast<size_t>(index)]->pool().host().data(), m_pools[static_cast<size_t>(index)]->pool().port(), candidate, current);
+    }
+
+    setActive(index, now);
+}
+
+
+void xmrig::LatencyStrategy::onClose(IClient *client, int failures)
+{
+    if (failures == -1) {
+        return;
+    }
+
+    State &state = m_states[static_cast<size_t>(client->id())];
+    state.ready  = false;
+
+    if (m_active != client->id()) {
+        return;
+    }
+
+    m_active = -1;
+
+    const int index = best(false);
+    if (index >= 0) {
+        setActive(index, Chrono::steadyMSecs());
+
+        return;
+    }
+
+    m_listener->onPause(this);
+}
+
+
+void xmrig::LatencyStrategy::onJobReceived(IClient *client, const Job &job, const rapidjson::Value &params)
+{
+    State &state = m_states[static_cast<size_t>(client->id())];
+
+    updateDelay(state, job.height(), Chrono::steadyMSecs());
+
+    if (m_active == client->id()) {
+        m_listener->onJob(this, client, job, params);
+    }
+}
+
+
+void xmrig::LatencyStrategy::onLogin(IClient *client, rapidjson::Document &doc, rapidjson::Value &params)
+{
+    m_states[static_cast<size_t>(client->id())].login = Chrono::steadyMSecs();
+
+    m_listener->onLogin(this, client, doc, params);
+}
+
+
+void xmrig::LatencyStrategy::onLoginSuccess(IClient *client)
+{
+    const uint64_t now = Chrono::steadyMSecs();
+    State &state       = m_states[static_cast<size_t>(client->id())];
+
+    state.ready   = true;
+    state.skipJob = true;
+    PoolRtt::sample(state.rtt, now - state.login);
+
+    if (!isActive()) {
+        m_active   = client->id();
+        m_switched = now;
+
+        m_listener->onActive(this, client);
+    }
+}
+
+
+void xmrig::LatencyStrategy::onResultAccepted(IClient *client, const SubmitResult &result, const char *error)
+{
+    PoolRtt::sample(m_states[static_cast<size_t>(client->id())].rtt, result, error);
+
+    m_listener->onResultAccepted(this, client, result, error);
+}
+
+
+void xmrig::LatencyStrategy::onVerifyAlgorithm(const IClient *client, const Algorithm &algorithm, bool *ok)
+{
+    m_listener->onVerifyAlgorithm(this, client, algorithm, ok);
+}
+
+
+int xmrig::LatencyStrategy::best(bool sampled) const
+{
+    int index = -1;
+
+    for (size_t i = 0; i < m_pools.size(); ++i) {
+        const State &state = m_states[i];
+
+        if (!state.ready || !m_pools[i]->job().isValid() || (sampled && state.samples < kMinSamples)) {
+            continue;
+        }
+
+        if (index < 0 || state.latency() < m_states[static_cast<size_t>(index)].latency()) {
+            index = static_cast<int>(i);
+        }
+    }
+
+    return index;
+}
+
+
+void xmrig::LatencyStrategy::setActive(int index, uint64_t now)
+{
+    IClient *client = m_pools[static_cast<size_t>(index)];
+    m_active        = index;
+    m_switched      = now;
+
+    m_listener->onActive(this, client);
+    m_listener->onJob(this, client, client->job(), rapidjson::Value(rapidjson::kNullType));
+}
+
+
+void xmrig::LatencyStrategy::updateDelay(State &state, uint64_t height, uint64_t now)
+{
+    if (height == 0) {
+        return;
+    }
+
+    auto it = m_arrivals.find(height);
+    if (it == m_arrivals.end()) {
+        if (m_arrivals.size() >= kMaxArrivals) {
+            m_arrivals.erase(m_arrivals.begin());
+        }
+
+        it = m_arrivals.emplace(height, now).first;
+    }
+
+    // The job that comes with the login response says nothing about how fast the pool announces new blocks,
+    // neither do repeated jobs for the same height (new transactions), only the first job of every height is measured
+    const bool skip = state.skipJob || height <= state.height;
+    state.skipJob   = false;
+    state.height    = std::max(state.height, height);
+
+    if (skip) {
+        return;
+    }
+
+    const uint64_t delay = std::min(now - it->second, kMaxDelay);
+    state.delay          = state.samples ? PoolRtt::average(state.delay, delay) : delay;
+    ++state.samples;
+}
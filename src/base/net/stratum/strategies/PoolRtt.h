@@ -0,0 +1,53 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_POOLRTT_H
+#define XMRIG_POOLRTT_H
+
+
+#include "base/net/stratum/SubmitResult.h"
+
+
+#include <cstdint>
+
+
+namespace xmrig {
+
+
+// Smoothed round-trip time of a pool as used by the strategies to rank pools: login and share result samples
+// are folded into a moving average (weight 1/4), the first sample is taken as is.
+class PoolRtt
+{
+public:
+    static inline uint64_t average(uint64_t value, uint64_t sample) { return (value * 3 + sample) / 4; }
+    static inline void sample(uint64_t &rtt, uint64_t value)            { rtt = rtt ? average(rtt, value) : value; }
+
+    // A rejected share may have been answered without the usual work, only accepted ones are samples
+    static inline void sample(uint64_t &rtt, const SubmitResult &result, const char *error)
+    {
+        if (!error) {
+            sample(rtt, result.elapsed);
+        }
+    }
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_POOLRTT_H */
@@ -23,13 +23,14 @@
 #include "base/kernel/interfaces/ILineListener.h"
 #include "base/net/tools/NetBuffer.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cstring>
 
 
 xmrig::LineReader::~LineReader()
 {
-    NetBuffer::release(m_buf);
+    reset();
 }
 
 
@@ -46,28 +47,67 @@ void xmrig::LineReader::parse(char *data, size_t size)
 
 void xmrig::LineReader::reset()
 {
-    if (m_buf) {
-        NetBuffer::release(m_buf);
-        m_buf = nullptr;
-        m_pos = 0;
+    for (char *chunk : m_chunks) {
+        NetBuffer::release(chunk);
     }
+
+    m_chunks.clear();
+    m_discard = false;
+    m_pos     = 0;
+    m_size    = 0;
 }
 
 
 void xmrig::LineReader::add(const char *data, size_t size)
 {
-    if (size + m_pos > XMRIG_NET_BUFFER_CHUNK_SIZE) {
-        // it breaks correctness silently for long lines
+    while (size > 0) {
+        if (m_chunks.empty() || m_pos == XMRIG_NET_BUFFER_CHUNK_SIZE) {
+            m_chunks.push_back(NetBuffer::allocate());
+            m_pos = 0;
+        }
+
+        const size_t n = std::min(size, XMRIG_NET_BUFFER_CHUNK_SIZE - m_pos);
+        memcpy(m_chunks.back() + m_pos, data, n);
+
+        m_pos  += n;
+        m_size += n;
+        data   += n;
+        size   -= n;
+    }
+}
+
+
+void xmrig::LineReader::flush()
+{
+    // The listener may call reset(), so the buffered line is detached first
+    const size_t size = m_size - 1;
+    m_pos  = 0;
+    m_size = 0;
+
+    if (m_chunks.size() == 1) {
+        char *chunk = m_chunks.front();
+        m_chunks.clear();
+
+        m_listener->onLine(chunk, size);
+        NetBuffer::release(chunk);
+
         return;
     }
 
-    if (!m_buf) {
-        m_buf = NetBuffer::allocate();
-        m_pos = 0;
+    // Only a line spanning several chunks is coalesced into one contiguous buffer
+    std::vector<char> line(size + 1);
+    size_t offset = 0;
+
+    for (char *chunk : m_chunks) {
+        const size_t n = std::min(line.size() - offset, XMRIG_NET_BUFFER_CHUNK_SIZE);
+        memcpy(line.data() + offset, chunk, n);
+        offset += n;
+
+        NetBuffer::release(chunk);
     }
 
-    memcpy(m_buf + m_pos, data, size);
-    m_pos += size;
+    m_chunks.clear();
+    m_listener->onLine(line.data(), size);
 }
 
 
@@ -83,10 +123,16 @@ void xmrig::LineReader::getline(char *data, size_t size)
         end++;
 
         const auto len = static_cast<size_t>(end - start);
-        if (m_pos) {
+        if (m_discard) {
+            // End of the line that was already reported as too long
+            m_discard = false;
+        }
+        else if (m_size + len - 1 > m_maxSize) {
+            overflow(m_size + len - 1, false);
+        }
+        else if (m_size) {
             add(start, len);
-            m_listener->onLine(m_buf, m_pos - 1);
-            m_pos = 0;
+            flush();
         }
         else if (len > 1) {
             m_listener->onLine(start, len - 1);
@@ -96,9 +142,22 @@ void xmrig::LineReader::getline(char *data, size_t size)
         start = end;
     }
 
-    if (remaining == 0) {
-        return reset();
+    if (remaining == 0 || m_discard) {
+        return;
+    }
+
+    if (m_size + remaining > m_maxSize) {
+        return overflow(m_size + remaining, true);
     }
 
     add(start, remaining);
 }
+
+
+void xmrig::LineReader::overflow(size_t size, bool partial)
+{
+    reset();
+    m_discard = partial;
+
+    m_listener->onLineTooLong(size);
+}
@@ -21,10 +21,12 @@
 #define XMRIG_LINEREADER_H
 
 
+#include "base/kernel/constants.h"
 #include "base/tools/Object.h"
 
 
 #include <cstddef>
+#include <vector>
 
 
 namespace xmrig {
@@ -42,18 +44,25 @@ public:
     LineReader(ILineListener *listener) : m_listener(listener) {}
     ~LineReader();
 
-    inline void setListener(ILineListener *listener) { m_listener = listener; }
+    inline size_t maxSize() const                       { return m_maxSize; }
+    inline void setListener(ILineListener *listener)    { m_listener = listener; }
+    inline void setMaxSize(size_t size)                 { m_maxSize = size; }
 
     void parse(char *data, size_t size);
     void reset();
 
 private:
     void add(const char *data, size_t size);
+    void flush();
     void getline(char *data, size_t size);
+    void overflow(size_t size, bool partial);
 
-    char *m_buf                 = nullptr;
+    bool m_discard              = false;
     ILineListener *m_listener   = nullptr;
+    size_t m_maxSize            = XMRIG_NET_LINE_MAX_SIZE;
     size_t m_pos                = 0;
+    size_t m_size               = 0;
+    std::vector<char *> m_chunks;
 };
 
 
@@ -20,41 +20,42 @@
 #define XMRIG_MEMPOOL_H
 
 
-#include <array>
 #include <cassert>
 #include <cstddef>
-#include <map>
-#include <set>
+#include <cstring>
+#include <memory>
+#include <vector>
 
 
 namespace xmrig {
 
 
+// Fixed size chunks carved from slabs of INIT_SIZE chunks. Free chunks form an intrusive singly-linked list, the pointer
+// to the next free chunk is stored in the first bytes of the chunk itself, so allocate() and deallocate() are O(1) and
+// never touch the heap unless a new slab is needed. Slabs are released only with the pool.
 template<size_t CHUNK_SIZE, size_t INIT_SIZE>
 class MemPool
 {
+    static_assert(CHUNK_SIZE >= sizeof(char *), "Chunk must be able to hold the free list link");
+
 public:
     MemPool() = default;
 
 
     constexpr size_t chunkSize() const  { return CHUNK_SIZE; }
-    inline size_t freeSize() const      { return m_free.size() * CHUNK_SIZE; }
+    inline size_t freeSize() const      { return m_freeCount * CHUNK_SIZE; }
     inline size_t size() const          { return m_data.size() * CHUNK_SIZE * INIT_SIZE; }
 
 
     inline char *allocate()
     {
-        if (m_free.empty()) {
+        if (m_free == nullptr) {
             resize();
         }
 
-        const size_t i = *m_free.begin();
-        const size_t r = i / INIT_SIZE;
-
-        char *ptr = m_data[r].data() + (i - r * INIT_SIZE) * CHUNK_SIZE;
-
-        m_used.insert({ ptr, i });
-        m_free.erase(i);
+        char *ptr = m_free;
+        memcpy(&m_free, ptr, sizeof(m_free));
+        --m_freeCount;
 
         return ptr;
     }
@@ -66,28 +67,45 @@ public:
             return;
         }
 
-        assert(m_used.count(ptr));
+        assert(owns(ptr));
 
-        m_free.emplace(m_used[ptr]);
-        m_used.erase(ptr);
+        char *chunk = const_cast<char *>(ptr);
+        memcpy(chunk, &m_free, sizeof(m_free));
+        m_free = chunk;
+        ++m_freeCount;
     }
 
 
 private:
     inline void resize()
     {
-        const size_t index = m_data.size();
-        m_data[index];
+        m_data.emplace_back(new char[CHUNK_SIZE * INIT_SIZE]);
+        char *slab = m_data.back().get();
 
-        for (size_t i = 0; i < INIT_SIZE; ++i) {
-            m_free.emplace((index * INIT_SIZE) + i);
+        // Link the new chunks in address order, so the first allocation takes the start of the slab
+        for (size_t i = INIT_SIZE; i > 0; --i) {
+            deallocate(slab + (i - 1) * CHUNK_SIZE);
         }
     }
 
 
-    std::map<const char *, size_t> m_used;
-    std::map<size_t, std::array<char, CHUNK_SIZE * INIT_SIZE> > m_data;
-    std::set<size_t> m_free;
+#   ifndef NDEBUG
+    bool owns(const char *ptr) const
+    {
+        for (const auto &slab : m_data) {
+            if (ptr >= slab.get() && ptr < slab.get() + CHUNK_SIZE * INIT_SIZE) {
+                return (ptr - slab.get()) % CHUNK_SIZE == 0;
+            }
+        }
+
+        return false;
+    }
+#   endif
+
+
+    char *m_free        = nullptr;
+    size_t m_freeCount  = 0;
+    std::vector<std::unique_ptr<char[]> > m_data;
 };
 
 
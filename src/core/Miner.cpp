@@ -31,11 +31,13 @@
 #include "base/io/log/Tags.h"
 #include "base/kernel/Platform.h"
 #include "base/net/stratum/Job.h"
+#include "base/tools/Chrono.h"
 #include "base/tools/Object.h"
 #include "base/tools/Timer.h"
 #include "core/config/Config.h"
 #include "core/Controller.h"
 #include "crypto/common/Nonce.h"
+#include "net/JobLatency.h"
 #include "version.h"
 
 
@@ -124,6 +126,13 @@ public:
             Nonce::reset(job.index());
         }
 
+        // Stamped here rather than in Miner::setJob, so a deferred RandomX dataset init counts as part of "ready"
+        mutex.lock();
+        if (!job.trace(Job::TRACE_READY)) {
+            job.setTrace(Job::TRACE_READY, Chrono::steadyUSecs());
+        }
+        mutex.unlock();
+
         for (IBackend *backend : backends) {
             backend->setJob(job);
         }
@@ -348,6 +357,8 @@ public:
                  avg_hashrate_buf
                  );
 
+        JobLatency::print();
+
 #       ifdef XMRIG_FEATURE_BENCHMARK
         for (auto backend : backends) {
             backend->printBenchProgress();
@@ -551,6 +562,8 @@ void xmrig::Miner::setEnabled(bool enabled)
 
 void xmrig::Miner::setJob(const Job &job, bool donate)
 {
+    const uint64_t dispatched = Chrono::steadyUSecs();
+
     for (IBackend *backend : d_ptr->backends) {
         backend->prepare(job);
     }
@@ -582,6 +595,7 @@ void xmrig::Miner::setJob(const Job &job, bool donate)
 
     d_ptr->job   = job;
     d_ptr->job.setIndex(index);
+    d_ptr->job.setTrace(Job::TRACE_DISPATCHED, dispatched);
 
     if (index == 0) {
         d_ptr->userJobId = job.id();
@@ -709,12 +723,21 @@ void xmrig::Miner::onRequest(IApiRequest &request)
 
             d_ptr->getMiner(request.reply(), request.doc(), request.version());
             d_ptr->getHashrate(request.reply(), request.doc(), request.version());
+
+            request.reply().AddMember("job_latency", JobLatency::toJSON(request.doc()), request.doc().GetAllocator());
         }
         else if (request.url() == "/2/backends") {
             request.accept();
 
             d_ptr->getBackends(request.reply(), request.doc());
         }
+#       ifdef XMRIG_ALGO_GHOSTRIDER
+        else if (request.url() == "/2/ghostrider") {
+            request.accept();
+
+            ghostrider::tune_to_json(request.reply(), request.doc());
+        }
+#       endif
     }
     else if (request.type() == IApiRequest::REQ_JSON_RPC) {
         if (request.rpcMethod() == "pause") {
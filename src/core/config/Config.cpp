@@ -138,6 +138,14 @@ const xmrig::CpuConfig &xmrig::Config::cpu() const
 }
 
 
+#ifdef XMRIG_ALGO_ARGON2
+void xmrig::Config::setArgon2Tuned(const String &impl)
+{
+    d_ptr->cpu.setArgon2Tuned(impl);
+}
+#endif
+
+
 uint32_t xmrig::Config::idleTime() const
 {
     return d_ptr->idleTime * 1000U;
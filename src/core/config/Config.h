@@ -96,6 +96,10 @@ public:
     static constexpr inline bool isDMI()    { return false; }
 #   endif
 
+#   ifdef XMRIG_ALGO_ARGON2
+    void setArgon2Tuned(const String &impl);
+#   endif
+
     bool isShouldSave() const;
     bool read(const IJsonReader &reader, const char *fileName) override;
     void getJSON(rapidjson::Document &doc) const override;
@@ -52,6 +52,8 @@ R"===(
         "rdmsr": true,
         "wrmsr": true,
         "cache_qos": false,
+        "threaded-interpreter": true,
+        "jit": "auto",
         "numa": true,
         "scratchpad_prefetch_mode": 1
     },
@@ -63,9 +65,11 @@ R"===(
         "priority": null,
         "memory-pool": false,
         "yield": true,
+        "cn-layout": null,
         "max-threads-hint": 100,
         "asm": true,
         "argon2-impl": null,
+        "kawpow-dag": false,
         "cn/0": false,
         "cn-lite/0": false
     },
@@ -98,6 +102,7 @@ R"===(
             "rig-id": null,
             "nicehash": false,
             "keepalive": false,
+            "submit-window": 0,
             "enabled": true,
             "tls": false,
             "tls-fingerprint": null,
@@ -112,6 +117,8 @@ R"===(
     "dmi": true,
     "retries": 5,
     "retry-pause": 5,
+    "pool-standby": 0,
+    "pool-strategy": "failover",
     "syslog": false,
     "tls": {
         "enabled": false,
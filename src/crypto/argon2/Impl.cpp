@@ -23,19 +23,74 @@
  */
 
 
+#include "crypto/argon2/Impl.h"
 #include "3rdparty/argon2.h"
+#include "base/crypto/Algorithm.h"
+#include "base/io/log/Log.h"
+#include "base/io/log/Tags.h"
 #include "base/tools/String.h"
-#include "crypto/argon2/Impl.h"
+#include "crypto/common/VirtualMemory.h"
+
 
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
 
 
 namespace xmrig {
 
 
 static bool selected = false;
+static bool tuned    = false;
 static String implName;
 
 
+#if defined(__x86_64__) || defined(_M_AMD64)
+static constexpr uint32_t kTuneTime = 250; // ms per implementation
+
+
+// Memory fills per kTuneTime with implementation `index`, all threads filling at once. The implementation is called
+// directly, so workers that hash with the selected one at the same time are not affected.
+static uint64_t measure(const Algorithm &algorithm, size_t threads, size_t index)
+{
+    uint32_t passes = 4;
+    if (algorithm == Algorithm::AR2_CHUKWA) {
+        passes = 3;
+    }
+
+    const auto blocks = static_cast<uint32_t>(algorithm.l3() / 1024);
+
+    std::atomic<bool> stop(false);
+    std::atomic<uint64_t> hashes(0);
+    std::vector<std::thread> workers;
+    workers.reserve(threads);
+
+    for (size_t i = 0; i < threads; ++i) {
+        workers.emplace_back([&algorithm, &stop, &hashes, index, blocks, passes]() {
+            VirtualMemory memory(algorithm.l3(), false, false, false);
+            uint64_t count = 0;
+
+            while (!stop.load(std::memory_order_relaxed) && argon2_fill_with_impl(index, memory.scratchpad(), blocks, passes)) {
+                ++count;
+            }
+
+            hashes += count;
+        });
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(kTuneTime));
+    stop = true;
+
+    for (auto &worker : workers) {
+        worker.join();
+    }
+
+    return hashes;
+}
+#endif
+
+
 } // namespace xmrig
 
 
@@ -87,7 +142,51 @@ bool xmrig::argon2::Impl::select(const String &nameHint, bool benchmark)
 }
 
 
+bool xmrig::argon2::Impl::isTuned()
+{
+    return tuned;
+}
+
+
 const xmrig::String &xmrig::argon2::Impl::name()
 {
     return implName;
 }
+
+
+// Benchmarks every implementation and returns the fastest (empty if there is nothing to choose from). The selected
+// implementation is neither used nor changed, so this may run off the main thread.
+xmrig::String xmrig::argon2::Impl::tune(const Algorithm &algorithm, size_t threads)
+{
+    String best;
+
+#   if defined(__x86_64__) || defined(_M_AMD64)
+    uint64_t bestHashes = 0;
+
+    for (size_t i = 0; i < argon2_get_impl_count(); ++i) {
+        const char *name = argon2_get_available_impl_name(i);
+        if (!name) {
+            continue;
+        }
+
+        const uint64_t hashes = measure(algorithm, threads, i);
+
+        LOG_VERBOSE("%s " WHITE_BOLD("argon2") " %-8s %6.1f H/s", Tags::cpu(), name, hashes * 1000.0 / kTuneTime);
+
+        if (hashes > bestHashes) {
+            bestHashes = hashes;
+            best       = name;
+        }
+    }
+#   endif
+
+    return best;
+}
+
+
+void xmrig::argon2::Impl::setTuned()
+{
+    // let the next select() apply and report the winner, even if an implementation was already selected for RandomX
+    selected = false;
+    tuned    = true;
+}
@@ -26,9 +26,13 @@
 #define XMRIG_ARGON2_IMPL_H
 
 
+#include <cstddef>
+
+
 namespace xmrig {
 
 
+class Algorithm;
 class String;
 
 
@@ -38,8 +42,11 @@ namespace argon2 {
 class Impl
 {
 public:
+    static bool isTuned();
     static bool select(const String &nameHint, bool benchmark = false);
     static const String &name();
+    static String tune(const Algorithm &algorithm, size_t threads);
+    static void setTuned();
 };
 
 
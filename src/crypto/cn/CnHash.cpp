@@ -32,36 +32,114 @@
 
 #ifdef XMRIG_ALGO_ARGON2
 #   include "crypto/argon2/Hash.h"
+
+#   define ADD_FN_ARGON2(algo) do {                                                               \
+        static_assert(xmrig::indexOf(algo) < kAlgoCount, "algorithm is missing in kAlgorithms"); \
+        auto &f = m_data[xmrig::indexOf(algo)].data;                                             \
+        f[AV_SINGLE][Assembly::NONE]      = argon2::single_hash<algo>;                           \
+        f[AV_SINGLE_SOFT][Assembly::NONE] = argon2::single_hash<algo>;                           \
+        f[AV_DOUBLE][Assembly::NONE]      = argon2::multi_hash<algo, 2>;                         \
+        f[AV_DOUBLE_SOFT][Assembly::NONE] = argon2::multi_hash<algo, 2>;                         \
+        f[AV_TRIPLE][Assembly::NONE]      = argon2::multi_hash<algo, 3>;                         \
+        f[AV_TRIPLE_SOFT][Assembly::NONE] = argon2::multi_hash<algo, 3>;                         \
+        f[AV_QUAD][Assembly::NONE]        = argon2::multi_hash<algo, 4>;                         \
+        f[AV_QUAD_SOFT][Assembly::NONE]   = argon2::multi_hash<algo, 4>;                         \
+    } while (0)
 #endif
 
 
-#define ADD_FN(algo) do {                                                                            \
-        m_map[algo] = new cn_hash_fun_array{};                                                       \
-        m_map[algo]->data[AV_SINGLE][Assembly::NONE]      = cryptonight_single_hash<algo, false, 0>; \
-        m_map[algo]->data[AV_SINGLE_SOFT][Assembly::NONE] = cryptonight_single_hash<algo, true,  0>; \
-        m_map[algo]->data[AV_DOUBLE][Assembly::NONE]      = cryptonight_double_hash<algo, false>;    \
-        m_map[algo]->data[AV_DOUBLE_SOFT][Assembly::NONE] = cryptonight_double_hash<algo, true>;     \
-        m_map[algo]->data[AV_TRIPLE][Assembly::NONE]      = cryptonight_triple_hash<algo, false>;    \
-        m_map[algo]->data[AV_TRIPLE_SOFT][Assembly::NONE] = cryptonight_triple_hash<algo, true>;     \
-        m_map[algo]->data[AV_QUAD][Assembly::NONE]        = cryptonight_quad_hash<algo,   false>;    \
-        m_map[algo]->data[AV_QUAD_SOFT][Assembly::NONE]   = cryptonight_quad_hash<algo,   true>;     \
-        m_map[algo]->data[AV_PENTA][Assembly::NONE]       = cryptonight_penta_hash<algo,  false>;    \
-        m_map[algo]->data[AV_PENTA_SOFT][Assembly::NONE]  = cryptonight_penta_hash<algo,  true>;     \
+#define ADD_FN(algo) do {                                                                        \
+        static_assert(xmrig::indexOf(algo) < kAlgoCount, "algorithm is missing in kAlgorithms"); \
+        auto &f = m_data[xmrig::indexOf(algo)].data;                                             \
+        f[AV_SINGLE][Assembly::NONE]      = cryptonight_single_hash<algo, false, 0>;             \
+        f[AV_SINGLE_SOFT][Assembly::NONE] = cryptonight_single_hash<algo, true,  0>;             \
+        f[AV_DOUBLE][Assembly::NONE]      = cryptonight_double_hash<algo, false>;                \
+        f[AV_DOUBLE_SOFT][Assembly::NONE] = cryptonight_double_hash<algo, true>;                 \
+        f[AV_TRIPLE][Assembly::NONE]      = cryptonight_triple_hash<algo, false>;                \
+        f[AV_TRIPLE_SOFT][Assembly::NONE] = cryptonight_triple_hash<algo, true>;                 \
+        f[AV_QUAD][Assembly::NONE]        = cryptonight_quad_hash<algo,   false>;                \
+        f[AV_QUAD_SOFT][Assembly::NONE]   = cryptonight_quad_hash<algo,   true>;                 \
+        f[AV_PENTA][Assembly::NONE]       = cryptonight_penta_hash<algo,  false>;                \
+        f[AV_PENTA_SOFT][Assembly::NONE]  = cryptonight_penta_hash<algo,  true>;                 \
     } while (0)
 
 
+namespace xmrig {
+
+
+// Sorted by Id, the index of an algorithm in this array is its index in the flat CnHash table.
+static constexpr Algorithm::Id kAlgorithms[] = {
+    Algorithm::AR2_WRKZ,
+    Algorithm::AR2_CHUKWA,
+    Algorithm::AR2_CHUKWA_V2,
+    Algorithm::CN_UPX2,
+    Algorithm::CN_GR_4,
+    Algorithm::CN_GR_5,
+    Algorithm::CN_PICO_0,
+    Algorithm::CN_PICO_TLO,
+    Algorithm::CN_GR_0,
+    Algorithm::CN_GR_1,
+    Algorithm::CN_LITE_0,
+    Algorithm::CN_LITE_1,
+    Algorithm::CN_GR_3,
+    Algorithm::CN_0,
+    Algorithm::CN_CCX,
+    Algorithm::CN_XAO,
+    Algorithm::CN_1,
+    Algorithm::CN_GR_2,
+    Algorithm::CN_FAST,
+    Algorithm::CN_RTO,
+    Algorithm::CN_2,
+    Algorithm::CN_DOUBLE,
+    Algorithm::CN_HALF,
+    Algorithm::CN_R,
+    Algorithm::CN_RWZ,
+    Algorithm::CN_ZLS,
+    Algorithm::CN_HEAVY_0,
+    Algorithm::CN_HEAVY_XHV,
+    Algorithm::CN_HEAVY_TUBE
+};
+
+
+static constexpr size_t kAlgorithmsCount = sizeof(kAlgorithms) / sizeof(kAlgorithms[0]);
+
+
+static constexpr bool isSorted(size_t i = 1)
+{
+    return i >= kAlgorithmsCount || (kAlgorithms[i - 1] < kAlgorithms[i] && isSorted(i + 1));
+}
+
+
+static_assert(isSorted(), "kAlgorithms must be sorted");
+
+
+// Binary search, returns kAlgorithmsCount for unknown algorithms.
+static constexpr size_t indexOf(Algorithm::Id id, size_t first = 0, size_t last = kAlgorithmsCount)
+{
+    return first >= last ? kAlgorithmsCount
+                         : kAlgorithms[(first + last) / 2] == id ? (first + last) / 2
+                         : kAlgorithms[(first + last) / 2] < id  ? indexOf(id, (first + last) / 2 + 1, last)
+                                                                 : indexOf(id, first, (first + last) / 2);
+}
+
+
+} // namespace xmrig
+
+
 bool cn_sse41_enabled = false;
 bool cn_vaes_enabled = false;
+bool cn_vaes512_enabled = false;
 
 
 #ifdef XMRIG_FEATURE_ASM
-#   define ADD_FN_ASM(algo) do {                                                                                    \
-        m_map[algo]->data[AV_SINGLE][Assembly::INTEL]     = cryptonight_single_hash_asm<algo, Assembly::INTEL>;     \
-        m_map[algo]->data[AV_SINGLE][Assembly::RYZEN]     = cryptonight_single_hash_asm<algo, Assembly::RYZEN>;     \
-        m_map[algo]->data[AV_SINGLE][Assembly::BULLDOZER] = cryptonight_single_hash_asm<algo, Assembly::BULLDOZER>; \
-        m_map[algo]->data[AV_DOUBLE][Assembly::INTEL]     = cryptonight_double_hash_asm<algo, Assembly::INTEL>;     \
-        m_map[algo]->data[AV_DOUBLE][Assembly::RYZEN]     = cryptonight_double_hash_asm<algo, Assembly::RYZEN>;     \
-        m_map[algo]->data[AV_DOUBLE][Assembly::BULLDOZER] = cryptonight_double_hash_asm<algo, Assembly::BULLDOZER>; \
+#   define ADD_FN_ASM(algo) do {                                                                    \
+        auto &f = m_data[xmrig::indexOf(algo)].data;                                                \
+        f[AV_SINGLE][Assembly::INTEL]     = cryptonight_single_hash_asm<algo, Assembly::INTEL>;     \
+        f[AV_SINGLE][Assembly::RYZEN]     = cryptonight_single_hash_asm<algo, Assembly::RYZEN>;     \
+        f[AV_SINGLE][Assembly::BULLDOZER] = cryptonight_single_hash_asm<algo, Assembly::BULLDOZER>; \
+        f[AV_DOUBLE][Assembly::INTEL]     = cryptonight_double_hash_asm<algo, Assembly::INTEL>;     \
+        f[AV_DOUBLE][Assembly::RYZEN]     = cryptonight_double_hash_asm<algo, Assembly::RYZEN>;     \
+        f[AV_DOUBLE][Assembly::BULLDOZER] = cryptonight_double_hash_asm<algo, Assembly::BULLDOZER>; \
     } while (0)
 
 
@@ -312,6 +390,8 @@ static const xmrig::CnHash cnHash;
 
 xmrig::CnHash::CnHash()
 {
+    static_assert(kAlgorithmsCount == kAlgoCount, "kAlgorithms and kAlgoCount mismatch");
+
     ADD_FN(Algorithm::CN_0);
     ADD_FN(Algorithm::CN_1);
     ADD_FN(Algorithm::CN_2);
@@ -357,17 +437,9 @@ xmrig::CnHash::CnHash()
 #   endif
 
 #   ifdef XMRIG_ALGO_ARGON2
-    m_map[Algorithm::AR2_CHUKWA] = new cn_hash_fun_array{};
-    m_map[Algorithm::AR2_CHUKWA]->data[AV_SINGLE][Assembly::NONE]         = argon2::single_hash<Algorithm::AR2_CHUKWA>;
-    m_map[Algorithm::AR2_CHUKWA]->data[AV_SINGLE_SOFT][Assembly::NONE]    = argon2::single_hash<Algorithm::AR2_CHUKWA>;
-
-    m_map[Algorithm::AR2_CHUKWA_V2] = new cn_hash_fun_array{};
-    m_map[Algorithm::AR2_CHUKWA_V2]->data[AV_SINGLE][Assembly::NONE]      = argon2::single_hash<Algorithm::AR2_CHUKWA_V2>;
-    m_map[Algorithm::AR2_CHUKWA_V2]->data[AV_SINGLE_SOFT][Assembly::NONE] = argon2::single_hash<Algorithm::AR2_CHUKWA_V2>;
-
-    m_map[Algorithm::AR2_WRKZ] = new cn_hash_fun_array{};
-    m_map[Algorithm::AR2_WRKZ]->data[AV_SINGLE][Assembly::NONE]           = argon2::single_hash<Algorithm::AR2_WRKZ>;
-    m_map[Algorithm::AR2_WRKZ]->data[AV_SINGLE_SOFT][Assembly::NONE]      = argon2::single_hash<Algorithm::AR2_WRKZ>;
+    ADD_FN_ARGON2(Algorithm::AR2_CHUKWA);
+    ADD_FN_ARGON2(Algorithm::AR2_CHUKWA_V2);
+    ADD_FN_ARGON2(Algorithm::AR2_WRKZ);
 #   endif
 
 #   ifdef XMRIG_ALGO_GHOSTRIDER
@@ -385,34 +457,30 @@ xmrig::CnHash::CnHash()
 }
 
 
-xmrig::CnHash::~CnHash()
+#ifdef XMRIG_ALGO_CN_HEAVY
+static bool isZen3Hack()
 {
-    for (auto const& x : m_map) {
-      delete m_map[x.first];
-    }
+    const auto arch      = xmrig::Cpu::info()->arch();
+    const uint32_t model = xmrig::Cpu::info()->model();
+
+    return ((arch == xmrig::ICpuInfo::ARCH_ZEN3) && (model == 0x21)) || ((arch == xmrig::ICpuInfo::ARCH_ZEN4) && (model == 0x61));
 }
+#endif
 
 
 xmrig::cn_hash_fun xmrig::CnHash::fn(const Algorithm &algorithm, AlgoVariant av, Assembly::Id assembly)
 {
-    assert(cnHash.m_map.count(algorithm));
-
-    if (!algorithm.isValid()) {
+    // Families without CryptoNight style functions (GhostRider) are not in kAlgorithms
+    const size_t index = indexOf(algorithm.id());
+    if (index >= kAlgoCount) {
         return nullptr;
     }
 
-    const auto it = cnHash.m_map.find(algorithm);
-    if (it == cnHash.m_map.end()) {
-        return nullptr;
-    }
+    const auto &functions = cnHash.m_data[index];
 
 #   ifdef XMRIG_ALGO_CN_HEAVY
     // cn-heavy optimization for Zen3/Zen4 CPUs
-    const auto arch = Cpu::info()->arch();
-    const uint32_t model = Cpu::info()->model();
-    const bool is_vermeer = (arch == ICpuInfo::ARCH_ZEN3) && (model == 0x21);
-    const bool is_raphael = (arch == ICpuInfo::ARCH_ZEN4) && (model == 0x61);
-    if ((av == AV_SINGLE) && (assembly != Assembly::NONE) && (is_vermeer || is_raphael)) {
+    if (interleave(algorithm, av, assembly) == 3) {
         switch (algorithm.id()) {
         case Algorithm::CN_HEAVY_0:
             return cryptonight_single_hash<Algorithm::CN_HEAVY_0, false, 3>;
@@ -430,11 +498,23 @@ xmrig::cn_hash_fun xmrig::CnHash::fn(const Algorithm &algorithm, AlgoVariant av,
 #   endif
 
 #   ifdef XMRIG_FEATURE_ASM
-    cn_hash_fun fun = it->second->data[av][Cpu::assembly(assembly)];
+    cn_hash_fun fun = functions.data[av][Cpu::assembly(assembly)];
     if (fun) {
         return fun;
     }
 #   endif
 
-    return it->second->data[av][Assembly::NONE];
+    return functions.data[av][Assembly::NONE];
+}
+
+
+uint32_t xmrig::CnHash::interleave(const Algorithm &algorithm, AlgoVariant av, Assembly::Id assembly)
+{
+#   ifdef XMRIG_ALGO_CN_HEAVY
+    if ((av == AV_SINGLE) && (assembly != Assembly::NONE) && (algorithm.family() == Algorithm::CN_HEAVY) && isZen3Hack()) {
+        return 3;
+    }
+#   endif
+
+    return 0;
 }
@@ -23,7 +23,6 @@
 
 #include <cstddef>
 #include <cstdint>
-#include <map>
 
 
 #include "crypto/cn/CnAlgo.h"
@@ -59,16 +58,19 @@ public:
     };
 
     CnHash();
-    virtual ~CnHash();
 
     static cn_hash_fun fn(const Algorithm &algorithm, AlgoVariant av, Assembly::Id assembly);
+    static uint32_t interleave(const Algorithm &algorithm, AlgoVariant av, Assembly::Id assembly);
 
 private:
+    static constexpr size_t kAlgoCount = 29;
+
     struct cn_hash_fun_array {
         cn_hash_fun data[AV_MAX][Assembly::MAX];
     };
 
-    std::map<Algorithm, cn_hash_fun_array*> m_map;
+    // Flat table, see kAlgorithms in CnHash.cpp for the index of each algorithm
+    cn_hash_fun_array m_data[kAlgoCount]{};
 };
 
 
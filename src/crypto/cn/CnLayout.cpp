@@ -0,0 +1,224 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "crypto/cn/CnLayout.h"
+#include "3rdparty/rapidjson/document.h"
+#include "base/io/json/Json.h"
+#include "crypto/common/VirtualMemory.h"
+
+
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <mutex>
+
+
+namespace xmrig {
+
+
+const char *CnLayout::kColour   = "colour";
+const char *CnLayout::kOverlap  = "overlap";
+const char *CnLayout::kShared   = "shared";
+const char *CnLayout::kSweep    = "sweep";
+
+const std::vector<size_t> CnLayout::kSweepColours = { 0, 64, 128, 192, 256, 512, 1024, 2048, 4096 };
+
+
+struct CnLayoutPool
+{
+    VirtualMemory *memory = nullptr;
+    size_t refs           = 0;
+};
+
+
+static std::atomic<size_t> sweepColourValue(0);
+static std::map<std::pair<uint32_t, size_t>, CnLayoutPool> pools;
+static std::mutex mutex;
+
+
+} // namespace xmrig
+
+
+xmrig::CnLayout::CnLayout(const rapidjson::Value &value)
+{
+    if (!value.IsObject()) {
+        return;
+    }
+
+    m_auto      = false;
+    m_colour    = Json::getUint(value, kColour) & ~63U;
+    m_overlap   = std::max(Json::getUint(value, kOverlap, 1), 1U);
+    m_shared    = Json::getBool(value, kShared);
+    m_sweep     = Json::getBool(value, kSweep);
+}
+
+
+xmrig::CnLayout::CnLayout(size_t colour, size_t overlap, bool shared, uint32_t interleave) :
+    m_auto(false),
+    m_shared(shared),
+    m_colour(colour),
+    m_overlap(overlap),
+    m_interleave(interleave)
+{
+}
+
+
+bool xmrig::CnLayout::isEqual(const CnLayout &other) const
+{
+    return m_auto       == other.m_auto &&
+           m_shared     == other.m_shared &&
+           m_sweep      == other.m_sweep &&
+           m_colour     == other.m_colour &&
+           m_overlap    == other.m_overlap &&
+           m_interleave == other.m_interleave;
+}
+
+
+xmrig::CnLayout xmrig::CnLayout::resolve(const Algorithm &algorithm, CnHash::AlgoVariant av, Assembly::Id assembly) const
+{
+    if (algorithm.family() == Algorithm::RANDOM_X) {
+        return { 0, 1, false };
+    }
+
+    const uint32_t interleave = CnHash::interleave(algorithm, av, assembly);
+
+    if (interleave == 0) {
+        // Overlapping scratchpads are only safe with the interleaved kernel
+        CnLayout layout = m_auto ? CnLayout(0, 1, false) : *this;
+        layout.m_overlap = 1;
+
+        return layout;
+    }
+
+    // cn-heavy optimization for Zen3/Zen4 CPUs: 8 threads share one scratchpad, each shifted by a cache line.
+    // A user layout is kept only if its shifts stay within one interleave step of the scratchpad.
+    const size_t step = 64U << interleave;
+    if (m_auto || m_sweep || (m_overlap > 1 && (m_colour == 0 || (m_overlap - 1) * m_colour >= step - 63))) {
+        return { 64, 8, true, interleave };
+    }
+
+    return { m_colour, m_overlap, m_shared, interleave };
+}
+
+
+rapidjson::Value xmrig::CnLayout::toJSON(rapidjson::Document &doc) const
+{
+    using namespace rapidjson;
+
+    if (m_auto) {
+        return Value(kNullType);
+    }
+
+    auto &allocator = doc.GetAllocator();
+
+    Value out(kObjectType);
+    out.AddMember(StringRef(kColour),   static_cast<uint64_t>(m_colour), allocator);
+    out.AddMember(StringRef(kOverlap),  static_cast<uint64_t>(m_overlap), allocator);
+    out.AddMember(StringRef(kShared),   m_shared, allocator);
+    out.AddMember(StringRef(kSweep),    m_sweep, allocator);
+
+    return out;
+}
+
+
+size_t xmrig::CnLayout::offset(size_t l3, size_t N, size_t slot, size_t hash, size_t colour) const
+{
+    return (slot / overlap()) * slotSize(l3, N) + ((slot % overlap()) * N + hash) * colour + hash * (l3 << m_interleave);
+}
+
+
+size_t xmrig::CnLayout::slotSize(size_t l3, size_t N) const
+{
+    // Interleaved scratchpads are shifted within their own gaps and need no room for colour
+    return N * (l3 << m_interleave) + (m_interleave ? 0 : overlap() * N * maxColour());
+}
+
+
+size_t xmrig::CnLayout::sweepColour()
+{
+    return sweepColourValue.load(std::memory_order_relaxed);
+}
+
+
+void xmrig::CnLayout::release(VirtualMemory *memory)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    for (auto it = pools.begin(); it != pools.end(); ++it) {
+        if (it->second.memory == memory) {
+            if (--it->second.refs == 0) {
+                delete memory;
+                pools.erase(it);
+            }
+
+            return;
+        }
+    }
+
+    delete memory;
+}
+
+
+void xmrig::CnLayout::setSweepColour(size_t colour)
+{
+    sweepColourValue = colour;
+}
+
+
+xmrig::VirtualMemory *xmrig::CnLayout::acquire(const CnLayout &layout, size_t l3, size_t N, size_t id, const std::vector<int64_t> &affinities, uint32_t node, bool hugePages, size_t &slot)
+{
+    slot = 0;
+
+    if (!layout.isShared()) {
+        return new VirtualMemory(layout.slotSize(l3, N), hugePages, false, true, node, VirtualMemory::kDefaultHugePageSize);
+    }
+
+    // Slots are numbered per NUMA node, so each node's pool only covers its own workers
+    size_t slots = 0;
+    for (size_t i = 0; i < affinities.size(); ++i) {
+        if (VirtualMemory::nodeOfCpu(affinities[i]) == node) {
+            slot  += i < id ? 1 : 0;
+            slots += 1;
+        }
+    }
+
+    if (slots == 0 || id >= affinities.size()) {
+        slot  = id;
+        slots = std::max(affinities.size(), id + 1);
+    }
+
+    const size_t size = (slots + layout.overlap() - 1) / layout.overlap() * layout.slotSize(l3, N);
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // Workers with different intensity have different slot sizes and never share a pool
+    auto &pool = pools[{ node, N }];
+    if (pool.memory == nullptr) {
+        pool.memory = new VirtualMemory(size, hugePages, false, false, node, VirtualMemory::kDefaultHugePageSize);
+    }
+    else if (pool.memory->size() < size) {
+        // Pool was created for another algorithm and is still in use, fall back to private memory
+        slot = 0;
+
+        return new VirtualMemory(layout.slotSize(l3, N), hugePages, false, true, node, VirtualMemory::kDefaultHugePageSize);
+    }
+
+    ++pool.refs;
+
+    return pool.memory;
+}
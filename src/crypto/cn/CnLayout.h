@@ -0,0 +1,103 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_CN_LAYOUT_H
+#define XMRIG_CN_LAYOUT_H
+
+
+#include "3rdparty/rapidjson/fwd.h"
+#include "crypto/cn/CnHash.h"
+
+
+#include <vector>
+
+
+namespace xmrig
+{
+
+
+class VirtualMemory;
+
+
+/*
+ * Placement of CryptoNight scratchpads in memory.
+ *
+ * Scratchpad `hash` of the worker in `slot` starts at:
+ *
+ *   (slot / overlap) * slotSize + ((slot % overlap) * N + hash) * colour + hash * (l3 << interleave)
+ *
+ * colour   extra bytes between consecutive scratchpads, so equal scratchpad offsets
+ *          don't map to the same cache sets;
+ * shared   all workers of a NUMA node take their slot from one pool instead of
+ *          allocating memory each;
+ * overlap  number of consecutive workers of a shared pool whose scratchpads overlap,
+ *          shifted by colour only. Only valid with the interleaved cn-heavy kernel used on
+ *          Zen3/Zen4 (colour 64, overlap 8), which spreads each scratchpad over l3 << 3
+ *          bytes so the shifted scratchpads fill each other's gaps; resolve() drops it otherwise.
+ */
+class CnLayout
+{
+public:
+    static const char *kColour;
+    static const char *kOverlap;
+    static const char *kShared;
+    static const char *kSweep;
+
+    static const std::vector<size_t> kSweepColours;
+
+    CnLayout() = default;
+    CnLayout(const rapidjson::Value &value);
+    CnLayout(size_t colour, size_t overlap, bool shared, uint32_t interleave = 0);
+
+    inline bool isAuto() const                          { return m_auto; }
+    inline bool isShared() const                        { return m_shared; }
+    inline bool isSweep() const                         { return m_sweep; }
+    inline size_t colour() const                        { return m_colour; }
+    inline uint32_t interleave() const                  { return m_interleave; }
+    inline size_t overlap() const                       { return m_shared ? m_overlap : 1; }
+
+    inline bool operator!=(const CnLayout &other) const { return !isEqual(other); }
+    inline bool operator==(const CnLayout &other) const { return isEqual(other); }
+
+    bool isEqual(const CnLayout &other) const;
+    CnLayout resolve(const Algorithm &algorithm, CnHash::AlgoVariant av, Assembly::Id assembly) const;
+    rapidjson::Value toJSON(rapidjson::Document &doc) const;
+    size_t offset(size_t l3, size_t N, size_t slot, size_t hash, size_t colour) const;
+    size_t slotSize(size_t l3, size_t N) const;
+
+    static size_t sweepColour();
+    static void release(VirtualMemory *memory);
+    static void setSweepColour(size_t colour);
+    static VirtualMemory *acquire(const CnLayout &layout, size_t l3, size_t N, size_t id, const std::vector<int64_t> &affinities, uint32_t node, bool hugePages, size_t &slot);
+
+private:
+    inline size_t maxColour() const                     { return m_sweep ? kSweepColours.back() : m_colour; }
+
+    bool m_auto         = true;
+    bool m_shared       = false;
+    bool m_sweep        = false;
+    size_t m_colour     = 0;
+    size_t m_overlap    = 1;
+    uint32_t m_interleave = 0;
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_CN_LAYOUT_H */
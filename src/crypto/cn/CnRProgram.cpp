@@ -0,0 +1,190 @@
+/* XMRig
+ * Copyright (c) 2018-2020 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2020 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <mutex>
+#include <vector>
+
+
+#include "crypto/cn/CnRProgram.h"
+#include "backend/cpu/Cpu.h"
+#include "crypto/cn/CryptoNight_monero.h"
+#include "crypto/common/VirtualMemory.h"
+
+
+void v4_compile_code(const V4_Instruction *code, int code_size, void *machine_code, xmrig::Assembly ASM);
+void v4_compile_code_double(const V4_Instruction *code, int code_size, void *machine_code, xmrig::Assembly ASM);
+void v4_soft_aes_compile_code(const V4_Instruction *code, int code_size, void *machine_code, xmrig::Assembly ASM);
+
+
+namespace xmrig {
+
+
+// Executable memory is allocated in blocks of kSlots programs, a new block is added only if every slot is in use
+constexpr size_t kSlotSize  = 0x4000;
+constexpr size_t kSlots     = 16;
+
+
+struct CnRSlot
+{
+    uint8_t *code           = nullptr;
+    uint64_t height         = 0;
+    uint64_t lastUse        = 0;
+    size_t refs             = 0;
+    Algorithm::Id algo      = Algorithm::INVALID;
+    CnRProgram::Kind kind   = CnRProgram::KIND_MAX;
+    Assembly::Id assembly   = Assembly::NONE;
+};
+
+
+static std::vector<CnRSlot> slots;
+static std::mutex mutex;
+static uint64_t counter = 0;
+
+
+static void unpin(cn_mainloop_fun_ms_abi code)
+{
+    if (!code) {
+        return;
+    }
+
+    for (auto &slot : slots) {
+        if (reinterpret_cast<cn_mainloop_fun_ms_abi>(slot.code) == code) {
+            --slot.refs;
+
+            return;
+        }
+    }
+}
+
+
+static CnRSlot &compile(Algorithm::Id algo, uint64_t height, CnRProgram::Kind kind, Assembly::Id assembly)
+{
+    // Programs pinned by a context may be executing on another worker right now and are never replaced
+    size_t index = slots.size();
+    for (size_t i = 0; i < slots.size(); ++i) {
+        if (slots[i].refs == 0 && (index == slots.size() || slots[i].lastUse < slots[index].lastUse)) {
+            index = i;
+        }
+    }
+
+    if (index == slots.size()) {
+        auto *memory = static_cast<uint8_t *>(VirtualMemory::allocateExecutableMemory(kSlotSize * kSlots, false));
+
+        slots.resize(index + kSlots);
+        for (size_t i = 0; i < kSlots; ++i) {
+            slots[index + i].code = memory + i * kSlotSize;
+        }
+    }
+
+    auto &slot  = slots[index];
+    uint8_t *p  = slot.code;
+
+    V4_Instruction code[256];
+    const int code_size = v4_random_math_init<Algorithm::CN_R>(code, height);
+
+    VirtualMemory::protectRW(p, kSlotSize);
+
+    switch (kind) {
+    case CnRProgram::SINGLE:
+        v4_compile_code(code, code_size, p, assembly);
+        break;
+
+    case CnRProgram::DOUBLE:
+        v4_compile_code_double(code, code_size, p, assembly);
+        break;
+
+    default:
+        v4_soft_aes_compile_code(code, code_size, p, Assembly::NONE);
+        break;
+    }
+
+    VirtualMemory::protectRX(p, kSlotSize);
+
+    slot.algo       = algo;
+    slot.height     = height;
+    slot.kind       = kind;
+    slot.assembly   = assembly;
+
+    return slot;
+}
+
+
+static CnRSlot &find(Algorithm::Id algo, uint64_t height, CnRProgram::Kind kind, Assembly::Id assembly)
+{
+    for (auto &slot : slots) {
+        if (slot.algo == algo && slot.height == height && slot.kind == kind && slot.assembly == assembly) {
+            slot.lastUse = ++counter;
+
+            return slot;
+        }
+    }
+
+    auto &slot   = compile(algo, height, kind, assembly);
+    slot.lastUse = ++counter;
+
+    return slot;
+}
+
+
+} // namespace xmrig
+
+
+cn_mainloop_fun_ms_abi xmrig::CnRProgram::get(Algorithm::Id algo, uint64_t height, Kind kind, Assembly::Id assembly, cn_mainloop_fun_ms_abi current)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    unpin(current);
+
+    auto &slot = find(algo, height, kind, assembly);
+    ++slot.refs;
+
+    return reinterpret_cast<cn_mainloop_fun_ms_abi>(slot.code);
+}
+
+
+void xmrig::CnRProgram::release(cn_mainloop_fun_ms_abi code)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    unpin(code);
+}
+
+
+void xmrig::CnRProgram::prepare(const Algorithm &algorithm, uint64_t height, Assembly::Id assembly, bool hwAES)
+{
+    if (algorithm != Algorithm::CN_R) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (!hwAES) {
+        find(algorithm, height, SOFT_AES, Assembly::NONE);
+
+        return;
+    }
+
+    assembly = Cpu::assembly(assembly);
+    if (assembly == Assembly::NONE) {
+        return;
+    }
+
+    find(algorithm, height, SINGLE, assembly);
+    find(algorithm, height, DOUBLE, assembly);
+}
@@ -0,0 +1,62 @@
+/* XMRig
+ * Copyright (c) 2018-2020 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2020 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_CN_R_PROGRAM_H
+#define XMRIG_CN_R_PROGRAM_H
+
+
+#include <cstdint>
+
+
+#include "base/crypto/Algorithm.h"
+#include "crypto/cn/CryptoNight.h"
+#include "crypto/common/Assembly.h"
+
+
+namespace xmrig
+{
+
+
+/*
+ * Process wide cache of compiled CN/R main loops. A program depends only on the block height,
+ * so it is compiled once (normally by the job thread in prepare()) and every worker calls the
+ * same read-only code instead of recompiling it into a private buffer on each height change.
+ *
+ * get() pins the returned program until the context passes it back as `current` on the next
+ * call or to release(), so a program is never recompiled while a worker may be executing it.
+ */
+class CnRProgram
+{
+public:
+    enum Kind : uint32_t {
+        SINGLE,
+        DOUBLE,
+        SOFT_AES,
+        KIND_MAX
+    };
+
+    static cn_mainloop_fun_ms_abi get(Algorithm::Id algo, uint64_t height, Kind kind, Assembly::Id assembly, cn_mainloop_fun_ms_abi current);
+    static void prepare(const Algorithm &algorithm, uint64_t height, Assembly::Id assembly, bool hwAES);
+    static void release(cn_mainloop_fun_ms_abi code);
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_CN_R_PROGRAM_H */
@@ -43,6 +43,11 @@
 #include "crypto/cn/soft_aes.h"
 
 
+#ifdef XMRIG_FEATURE_ASM
+#   include "crypto/cn/CnRProgram.h"
+#endif
+
+
 #ifdef XMRIG_VAES
 #   include "crypto/cn/CryptoNight_x86_vaes.h"
 #endif
@@ -289,6 +294,37 @@ inline constexpr uint64_t interleaved_index<0>(uint64_t k)
 }
 
 
+#ifdef XMRIG_VAES
+// 4 scratchpads: a single 512-bit pass if the CPU has it, two 256-bit passes otherwise
+static inline void cn_explode_scratchpad_vaes_quad(cryptonight_ctx **ctx, size_t memory, bool half_mem)
+{
+#   ifdef XMRIG_VAES512
+    if (cn_vaes512_enabled) {
+        cn_explode_scratchpad_vaes512_quad(ctx, memory, half_mem);
+        return;
+    }
+#   endif
+
+    cn_explode_scratchpad_vaes_double(ctx[0], ctx[1], memory, half_mem);
+    cn_explode_scratchpad_vaes_double(ctx[2], ctx[3], memory, half_mem);
+}
+
+
+static inline void cn_implode_scratchpad_vaes_quad(cryptonight_ctx **ctx, size_t memory, bool half_mem)
+{
+#   ifdef XMRIG_VAES512
+    if (cn_vaes512_enabled) {
+        cn_implode_scratchpad_vaes512_quad(ctx, memory, half_mem);
+        return;
+    }
+#   endif
+
+    cn_implode_scratchpad_vaes_double(ctx[0], ctx[1], memory, half_mem);
+    cn_implode_scratchpad_vaes_double(ctx[2], ctx[3], memory, half_mem);
+}
+#endif
+
+
 template<Algorithm::Id ALGO, bool SOFT_AES, int interleave>
 static NOINLINE void cn_explode_scratchpad(cryptonight_ctx *ctx)
 {
@@ -588,9 +624,6 @@ static inline __m128i int_sqrt_v2(const uint64_t n0)
 }
 
 
-void v4_soft_aes_compile_code(const V4_Instruction *code, int code_size, void *machine_code, xmrig::Assembly ASM);
-
-
 alignas(64) static const uint32_t tweak1_table[256] = { 268435456,0,268435456,0,268435456,0,268435456,0,268435456,0,268435456,0,268435456,0,268435456,0,805306368,0,805306368,0,805306368,0,805306368,0,805306368,0,805306368,0,805306368,0,805306368,0,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,268435456,0,268435456,0,268435456,0,268435456,0,268435456,0,268435456,0,268435456,0,268435456,0,805306368,0,805306368,0,805306368,0,805306368,0,805306368,0,805306368,0,805306368,0,805306368,0,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,268435456,0,268435456,0,268435456,0,268435456,0,268435456,0,268435456,0,268435456,0,268435456,0,805306368,0,805306368,0,805306368,0,805306368,0,805306368,0,805306368,0,805306368,0,805306368,0,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,268435456,0,268435456,0,268435456,0,268435456,0,268435456,0,268435456,0,268435456,0,268435456,0,805306368,0,805306368,0,805306368,0,805306368,0,805306368,0,805306368,0,805306368,0,805306368,0,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456 };
 
 
@@ -691,13 +724,7 @@ inline void cryptonight_single_hash(const uint8_t *__restrict__ input, size_t si
 #   ifdef XMRIG_FEATURE_ASM
     if (SOFT_AES && props.isR()) {
         if (!ctx[0]->generated_code_data.match(ALGO, height)) {
-            V4_Instruction code[256];
-            const int code_size = v4_random_math_init<ALGO>(code, height);
-
-            if (ALGO == Algorithm::CN_R) {
-                v4_soft_aes_compile_code(code, code_size, reinterpret_cast<void*>(ctx[0]->generated_code), Assembly::NONE);
-            }
-
+            ctx[0]->generated_code      = CnRProgram::get(ALGO, height, CnRProgram::SOFT_AES, Assembly::NONE, ctx[0]->generated_code);
             ctx[0]->generated_code_data = { ALGO, height };
         }
 
@@ -919,24 +946,6 @@ extern cn_mainloop_fun cn_gr5_quad_mainloop_asm;
 } // namespace xmrig
 
 
-void v4_compile_code(const V4_Instruction* code, int code_size, void* machine_code, xmrig::Assembly ASM);
-void v4_compile_code_double(const V4_Instruction* code, int code_size, void* machine_code, xmrig::Assembly ASM);
-
-
-template<xmrig::Algorithm::Id ALGO>
-void cn_r_compile_code(const V4_Instruction* code, int code_size, void* machine_code, xmrig::Assembly ASM)
-{
-    v4_compile_code(code, code_size, machine_code, ASM);
-}
-
-
-template<xmrig::Algorithm::Id ALGO>
-void cn_r_compile_code_double(const V4_Instruction* code, int code_size, void* machine_code, xmrig::Assembly ASM)
-{
-    v4_compile_code_double(code, code_size, machine_code, ASM);
-}
-
-
 namespace xmrig {
 
 
@@ -946,10 +955,7 @@ inline void cryptonight_single_hash_asm(const uint8_t *__restrict__ input, size_
     constexpr CnAlgo<ALGO> props;
 
     if (props.isR() && !ctx[0]->generated_code_data.match(ALGO, height)) {
-        V4_Instruction code[256];
-        const int code_size = v4_random_math_init<ALGO>(code, height);
-        cn_r_compile_code<ALGO>(code, code_size, reinterpret_cast<void*>(ctx[0]->generated_code), ASM);
-
+        ctx[0]->generated_code      = CnRProgram::get(ALGO, height, CnRProgram::SINGLE, ASM, ctx[0]->generated_code);
         ctx[0]->generated_code_data = { ALGO, height };
     }
 
@@ -1052,10 +1058,7 @@ inline void cryptonight_double_hash_asm(const uint8_t *__restrict__ input, size_
     constexpr CnAlgo<ALGO> props;
 
     if (props.isR() && !ctx[0]->generated_code_data.match(ALGO, height)) {
-        V4_Instruction code[256];
-        const int code_size = v4_random_math_init<ALGO>(code, height);
-        cn_r_compile_code_double<ALGO>(code, code_size, reinterpret_cast<void*>(ctx[0]->generated_code), ASM);
-
+        ctx[0]->generated_code      = CnRProgram::get(ALGO, height, CnRProgram::DOUBLE, ASM, ctx[0]->generated_code);
         ctx[0]->generated_code_data = { ALGO, height };
     }
 
@@ -1550,8 +1553,7 @@ static NOINLINE void cryptonight_quad_hash_gr_sse41(const uint8_t* __restrict__
 
 #   ifdef XMRIG_VAES
     if (!props.isHeavy() && cn_vaes_enabled) {
-        cn_explode_scratchpad_vaes_double(ctx[0], ctx[1], props.memory(), props.half_mem());
-        cn_explode_scratchpad_vaes_double(ctx[2], ctx[3], props.memory(), props.half_mem());
+        cn_explode_scratchpad_vaes_quad(ctx, props.memory(), props.half_mem());
     }
     else
 #   endif
@@ -1578,8 +1580,7 @@ static NOINLINE void cryptonight_quad_hash_gr_sse41(const uint8_t* __restrict__
 
 #   ifdef XMRIG_VAES
     if (!props.isHeavy() && cn_vaes_enabled) {
-        cn_implode_scratchpad_vaes_double(ctx[0], ctx[1], props.memory(), props.half_mem());
-        cn_implode_scratchpad_vaes_double(ctx[2], ctx[3], props.memory(), props.half_mem());
+        cn_implode_scratchpad_vaes_quad(ctx, props.memory(), props.half_mem());
     }
     else
 #   endif
@@ -1843,8 +1844,7 @@ inline void cryptonight_quad_hash(const uint8_t *__restrict__ input, size_t size
 
 #   ifdef XMRIG_VAES
     if (!SOFT_AES && !props.isHeavy() && cn_vaes_enabled) {
-        cn_explode_scratchpad_vaes_double(ctx[0], ctx[1], props.memory(), props.half_mem());
-        cn_explode_scratchpad_vaes_double(ctx[2], ctx[3], props.memory(), props.half_mem());
+        cn_explode_scratchpad_vaes_quad(ctx, props.memory(), props.half_mem());
     }
     else
 #   endif
@@ -1906,8 +1906,7 @@ inline void cryptonight_quad_hash(const uint8_t *__restrict__ input, size_t size
 
 #   ifdef XMRIG_VAES
     if (!SOFT_AES && !props.isHeavy() && cn_vaes_enabled) {
-        cn_implode_scratchpad_vaes_double(ctx[0], ctx[1], props.memory(), props.half_mem());
-        cn_implode_scratchpad_vaes_double(ctx[2], ctx[3], props.memory(), props.half_mem());
+        cn_implode_scratchpad_vaes_quad(ctx, props.memory(), props.half_mem());
     }
     else
 #   endif
@@ -1950,7 +1949,19 @@ inline void cryptonight_penta_hash(const uint8_t *__restrict__ input, size_t siz
         if (props.half_mem()) {
             ctx[i]->first_half = true;
         }
-        cn_explode_scratchpad<ALGO, SOFT_AES, 0>(ctx[i]);
+    }
+
+#   ifdef XMRIG_VAES
+    if (!SOFT_AES && !props.isHeavy() && cn_vaes_enabled) {
+        cn_explode_scratchpad_vaes_quad(ctx, props.memory(), props.half_mem());
+        cn_explode_scratchpad_vaes(ctx[4], props.memory(), props.half_mem());
+    }
+    else
+#   endif
+    {
+        for (size_t i = 0; i < 5; i++) {
+            cn_explode_scratchpad<ALGO, SOFT_AES, 0>(ctx[i]);
+        }
     }
 
     uint8_t* l0  = ctx[0]->memory;
@@ -2010,8 +2021,20 @@ inline void cryptonight_penta_hash(const uint8_t *__restrict__ input, size_t siz
         CN_STEP4(4, ax4, bx40, bx41, cx4, l4, mc4, ptr4, idx4);
     }
 
+#   ifdef XMRIG_VAES
+    if (!SOFT_AES && !props.isHeavy() && cn_vaes_enabled) {
+        cn_implode_scratchpad_vaes_quad(ctx, props.memory(), props.half_mem());
+        cn_implode_scratchpad_vaes(ctx[4], props.memory(), props.half_mem());
+    }
+    else
+#   endif
+    {
+        for (size_t i = 0; i < 5; i++) {
+            cn_implode_scratchpad<ALGO, SOFT_AES, 0>(ctx[i]);
+        }
+    }
+
     for (size_t i = 0; i < 5; i++) {
-        cn_implode_scratchpad<ALGO, SOFT_AES, 0>(ctx[i]);
         keccakf(reinterpret_cast<uint64_t*>(ctx[i]->state), 24);
         extra_hashes[ctx[i]->state[0] & 3](ctx[i]->state, 200, output + 32 * i);
     }
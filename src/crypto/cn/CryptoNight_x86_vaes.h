@@ -41,6 +41,11 @@ void cn_explode_scratchpad_vaes_double(cryptonight_ctx* ctx1, cryptonight_ctx* c
 void cn_implode_scratchpad_vaes(cryptonight_ctx* ctx, size_t memory, bool half_mem);
 void cn_implode_scratchpad_vaes_double(cryptonight_ctx* ctx1, cryptonight_ctx* ctx2, size_t memory, bool half_mem);
 
+#ifdef XMRIG_VAES512
+void cn_explode_scratchpad_vaes512_quad(cryptonight_ctx** ctx, size_t memory, bool half_mem);
+void cn_implode_scratchpad_vaes512_quad(cryptonight_ctx** ctx, size_t memory, bool half_mem);
+#endif
+
 
 } // xmrig
 
@@ -0,0 +1,298 @@
+/* XMRig
+ * Copyright 2018-2020 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2020 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * 512-bit VAES explode/implode for 4 scratchpads at once: 128-bit lane j of every
+ * ZMM register belongs to ctx[j]. Memory is accessed in whole cache lines, a 4x4
+ * transpose of 128-bit lanes converts between the two layouts.
+ */
+
+#include "CryptoNight_x86_vaes.h"
+#include "CryptoNight_monero.h"
+#include "CryptoNight.h"
+
+
+#ifdef __GNUC__
+#   include <x86intrin.h>
+#else
+#   include <intrin.h>
+#endif
+
+
+// This will shift and xor tmp1 into itself as 4 32-bit vals such as
+// sl_xor(a1 a2 a3 a4) = a1 (a2^a1) (a3^a2^a1) (a4^a3^a2^a1)
+static FORCEINLINE __m128i sl_xor(__m128i tmp1)
+{
+    __m128i tmp4;
+    tmp4 = _mm_slli_si128(tmp1, 0x04);
+    tmp1 = _mm_xor_si128(tmp1, tmp4);
+    tmp4 = _mm_slli_si128(tmp4, 0x04);
+    tmp1 = _mm_xor_si128(tmp1, tmp4);
+    tmp4 = _mm_slli_si128(tmp4, 0x04);
+    tmp1 = _mm_xor_si128(tmp1, tmp4);
+    return tmp1;
+}
+
+
+template<uint8_t rcon>
+static FORCEINLINE void aes_genkey_sub(__m128i* xout0, __m128i* xout2)
+{
+    __m128i xout1 = _mm_aeskeygenassist_si128(*xout2, rcon);
+    xout1 = _mm_shuffle_epi32(xout1, 0xFF); // see PSHUFD, set all elems to 4th elem
+    *xout0 = sl_xor(*xout0);
+    *xout0 = _mm_xor_si128(*xout0, xout1);
+    xout1 = _mm_aeskeygenassist_si128(*xout0, 0x00);
+    xout1 = _mm_shuffle_epi32(xout1, 0xAA); // see PSHUFD, set all elems to 3rd elem
+    *xout2 = sl_xor(*xout2);
+    *xout2 = _mm_xor_si128(*xout2, xout1);
+}
+
+
+static NOINLINE void vaes512_genkey(const __m128i* const* memory, __m512i* k)
+{
+    alignas(64) __m128i keys[10][4];
+
+    for (int j = 0; j < 4; ++j) {
+        __m128i xout0 = _mm_load_si128(memory[j]);
+        __m128i xout2 = _mm_load_si128(memory[j] + 1);
+        keys[0][j] = xout0;
+        keys[1][j] = xout2;
+
+        aes_genkey_sub<0x01>(&xout0, &xout2);
+        keys[2][j] = xout0;
+        keys[3][j] = xout2;
+
+        aes_genkey_sub<0x02>(&xout0, &xout2);
+        keys[4][j] = xout0;
+        keys[5][j] = xout2;
+
+        aes_genkey_sub<0x04>(&xout0, &xout2);
+        keys[6][j] = xout0;
+        keys[7][j] = xout2;
+
+        aes_genkey_sub<0x08>(&xout0, &xout2);
+        keys[8][j] = xout0;
+        keys[9][j] = xout2;
+    }
+
+    for (int i = 0; i < 10; ++i) {
+        k[i] = _mm512_load_si512(keys[i]);
+    }
+}
+
+
+// GCC 12 warns about the _mm512_undefined_epi32() inside _mm512_shuffle_i64x2
+#if defined(__GNUC__) && !defined(__clang__)
+#   pragma GCC diagnostic push
+#   pragma GCC diagnostic ignored "-Wuninitialized"
+#   pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+
+// 4x4 transpose of 128-bit lanes, its own inverse
+static FORCEINLINE void vaes512_transpose(__m512i& a, __m512i& b, __m512i& c, __m512i& d)
+{
+    const __m512i t0 = _mm512_shuffle_i64x2(a, b, _MM_SHUFFLE(1, 0, 1, 0));
+    const __m512i t1 = _mm512_shuffle_i64x2(a, b, _MM_SHUFFLE(3, 2, 3, 2));
+    const __m512i t2 = _mm512_shuffle_i64x2(c, d, _MM_SHUFFLE(1, 0, 1, 0));
+    const __m512i t3 = _mm512_shuffle_i64x2(c, d, _MM_SHUFFLE(3, 2, 3, 2));
+
+    a = _mm512_shuffle_i64x2(t0, t2, _MM_SHUFFLE(2, 0, 2, 0));
+    b = _mm512_shuffle_i64x2(t0, t2, _MM_SHUFFLE(3, 1, 3, 1));
+    c = _mm512_shuffle_i64x2(t1, t3, _MM_SHUFFLE(2, 0, 2, 0));
+    d = _mm512_shuffle_i64x2(t1, t3, _MM_SHUFFLE(3, 1, 3, 1));
+}
+
+
+// 128 bytes (8 AES blocks) of each of the 4 inputs, block i of input j goes to lane j of x[i]
+static FORCEINLINE void vaes512_load(const uint8_t* const* p, __m512i* x)
+{
+    x[0] = _mm512_loadu_si512(p[0]);
+    x[1] = _mm512_loadu_si512(p[1]);
+    x[2] = _mm512_loadu_si512(p[2]);
+    x[3] = _mm512_loadu_si512(p[3]);
+    x[4] = _mm512_loadu_si512(p[0] + 64);
+    x[5] = _mm512_loadu_si512(p[1] + 64);
+    x[6] = _mm512_loadu_si512(p[2] + 64);
+    x[7] = _mm512_loadu_si512(p[3] + 64);
+
+    vaes512_transpose(x[0], x[1], x[2], x[3]);
+    vaes512_transpose(x[4], x[5], x[6], x[7]);
+}
+
+
+static FORCEINLINE void vaes512_store(uint8_t* const* p, const __m512i* x)
+{
+    __m512i y[8] = { x[0], x[1], x[2], x[3], x[4], x[5], x[6], x[7] };
+
+    vaes512_transpose(y[0], y[1], y[2], y[3]);
+    vaes512_transpose(y[4], y[5], y[6], y[7]);
+
+    _mm512_storeu_si512(p[0], y[0]);
+    _mm512_storeu_si512(p[1], y[1]);
+    _mm512_storeu_si512(p[2], y[2]);
+    _mm512_storeu_si512(p[3], y[3]);
+    _mm512_storeu_si512(p[0] + 64, y[4]);
+    _mm512_storeu_si512(p[1] + 64, y[5]);
+    _mm512_storeu_si512(p[2] + 64, y[6]);
+    _mm512_storeu_si512(p[3] + 64, y[7]);
+}
+
+
+static FORCEINLINE void vaes512_round(__m512i key, __m512i* x)
+{
+    x[0] = _mm512_aesenc_epi128(x[0], key);
+    x[1] = _mm512_aesenc_epi128(x[1], key);
+    x[2] = _mm512_aesenc_epi128(x[2], key);
+    x[3] = _mm512_aesenc_epi128(x[3], key);
+    x[4] = _mm512_aesenc_epi128(x[4], key);
+    x[5] = _mm512_aesenc_epi128(x[5], key);
+    x[6] = _mm512_aesenc_epi128(x[6], key);
+    x[7] = _mm512_aesenc_epi128(x[7], key);
+}
+
+
+namespace xmrig {
+
+
+NOINLINE void cn_explode_scratchpad_vaes512_quad(cryptonight_ctx** ctx, size_t memory, bool half_mem)
+{
+    const size_t N = (memory / 128) / (half_mem ? 2 : 1);
+
+    __m512i k[10];
+    __m512i x[8];
+
+    const __m128i* keys[4] = {
+        reinterpret_cast<const __m128i*>(ctx[0]->state),
+        reinterpret_cast<const __m128i*>(ctx[1]->state),
+        reinterpret_cast<const __m128i*>(ctx[2]->state),
+        reinterpret_cast<const __m128i*>(ctx[3]->state)
+    };
+
+    vaes512_genkey(keys, k);
+
+    {
+        const bool b = half_mem && !ctx[0]->first_half && !ctx[1]->first_half && !ctx[2]->first_half && !ctx[3]->first_half;
+        const uint8_t* p[4];
+
+        for (int j = 0; j < 4; ++j) {
+            p[j] = b ? ctx[j]->save_state : (ctx[j]->state + 64);
+        }
+
+        vaes512_load(p, x);
+    }
+
+    constexpr size_t prefetch_dist = 2048 / 128;
+
+    uint8_t* output[4] = { ctx[0]->memory, ctx[1]->memory, ctx[2]->memory, ctx[3]->memory };
+
+    for (size_t i = 0; i < N; ++i) {
+        if (i + prefetch_dist < N) {
+            for (int j = 0; j < 4; ++j) {
+                _mm_prefetch((const char*)(output[j] + prefetch_dist * 128), _MM_HINT_T0);
+                _mm_prefetch((const char*)(output[j] + prefetch_dist * 128 + 64), _MM_HINT_T0);
+            }
+        }
+
+        for (int r = 0; r < 10; ++r) {
+            vaes512_round(k[r], x);
+        }
+
+        vaes512_store(output, x);
+
+        for (int j = 0; j < 4; ++j) {
+            output[j] += 128;
+        }
+    }
+
+    if (half_mem && ctx[0]->first_half && ctx[1]->first_half && ctx[2]->first_half && ctx[3]->first_half) {
+        uint8_t* p[4] = { ctx[0]->save_state, ctx[1]->save_state, ctx[2]->save_state, ctx[3]->save_state };
+
+        vaes512_store(p, x);
+    }
+
+    _mm256_zeroupper();
+}
+
+
+NOINLINE void cn_implode_scratchpad_vaes512_quad(cryptonight_ctx** ctx, size_t memory, bool half_mem)
+{
+    const size_t N = (memory / 128) / (half_mem ? 2 : 1);
+
+    __m512i k[10];
+    __m512i x[8];
+    __m512i y[8];
+
+    const __m128i* keys[4] = {
+        reinterpret_cast<const __m128i*>(ctx[0]->state) + 2,
+        reinterpret_cast<const __m128i*>(ctx[1]->state) + 2,
+        reinterpret_cast<const __m128i*>(ctx[2]->state) + 2,
+        reinterpret_cast<const __m128i*>(ctx[3]->state) + 2
+    };
+
+    vaes512_genkey(keys, k);
+
+    uint8_t* state[4] = { ctx[0]->state + 64, ctx[1]->state + 64, ctx[2]->state + 64, ctx[3]->state + 64 };
+    vaes512_load(state, x);
+
+    for (size_t part = 0; part < (half_mem ? 2 : 1); ++part) {
+        if (half_mem && (part == 1)) {
+            for (int j = 0; j < 4; ++j) {
+                ctx[j]->first_half = false;
+            }
+
+            cn_explode_scratchpad_vaes512_quad(ctx, memory, half_mem);
+        }
+
+        const uint8_t* input[4] = { ctx[0]->memory, ctx[1]->memory, ctx[2]->memory, ctx[3]->memory };
+
+        for (size_t i = 0; i < N; ++i) {
+            vaes512_load(input, y);
+
+            for (int j = 0; j < 4; ++j) {
+                input[j] += 128;
+            }
+
+            if (i + 1 < N) {
+                for (int j = 0; j < 4; ++j) {
+                    _mm_prefetch((const char*)(input[j]), _MM_HINT_T0);
+                    _mm_prefetch((const char*)(input[j] + 64), _MM_HINT_T0);
+                }
+            }
+
+            for (int b = 0; b < 8; ++b) {
+                x[b] = _mm512_xor_si512(x[b], y[b]);
+            }
+
+            for (int r = 0; r < 10; ++r) {
+                vaes512_round(k[r], x);
+            }
+        }
+    }
+
+    vaes512_store(state, x);
+
+    _mm256_zeroupper();
+}
+
+
+} // xmrig
+
+#if defined(__GNUC__) && !defined(__clang__)
+#   pragma GCC diagnostic pop
+#endif
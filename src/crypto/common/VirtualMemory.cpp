@@ -114,10 +114,28 @@ xmrig::HugePagesInfo xmrig::VirtualMemory::hugePages() const
 
 
 #ifndef XMRIG_FEATURE_HWLOC
+bool xmrig::VirtualMemory::membind(void *, size_t, uint32_t)
+{
+    return false;
+}
+
+
+int64_t xmrig::VirtualMemory::nodeOf(const void *, size_t)
+{
+    return -1;
+}
+
+
 uint32_t xmrig::VirtualMemory::bindToNUMANode(int64_t)
 {
     return 0;
 }
+
+
+uint32_t xmrig::VirtualMemory::nodeOfCpu(int64_t)
+{
+    return 0;
+}
 #endif
 
 
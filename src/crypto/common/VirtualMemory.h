@@ -58,16 +58,22 @@ public:
 
     static bool isHugepagesAvailable();
     static bool isOneGbPagesAvailable();
+    static bool membind(void *p, size_t size, uint32_t node);
     static bool protectRW(void *p, size_t size);
     static bool protectRWX(void *p, size_t size);
     static bool protectRX(void *p, size_t size);
+    static int64_t nodeOf(const void *p, size_t size);
+    static size_t pageSize(const void *p);
     static uint32_t bindToNUMANode(int64_t affinity);
+    static uint32_t nodeOfCpu(int64_t affinity);
+    static void *allocateDualMappedMemory(size_t size, void **writable);
     static void *allocateExecutableMemory(size_t size, bool hugePages);
     static void *allocateLargePagesMemory(size_t size);
     static void *allocateOneGbPagesMemory(size_t size);
     static bool adviseLargePages(void *p, size_t size);
     static void destroy();
     static void flushInstructionCache(void *p, size_t size);
+    static void freeDualMappedMemory(void *p, void *writable, size_t size);
     static void freeLargePagesMemory(void *p, size_t size);
     static void init(size_t poolSize, size_t hugePageSize);
 
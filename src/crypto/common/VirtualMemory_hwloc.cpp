@@ -42,3 +42,58 @@ uint32_t xmrig::VirtualMemory::bindToNUMANode(int64_t affinity)
 
     return hwloc_bitmap_first(pu->nodeset);
 }
+
+
+uint32_t xmrig::VirtualMemory::nodeOfCpu(int64_t affinity)
+{
+    if (affinity < 0 || Cpu::info()->nodes() < 2) {
+        return 0;
+    }
+
+    auto pu = hwloc_get_pu_obj_by_os_index(Cpu::info()->topology(), static_cast<unsigned>(affinity));
+
+    return pu ? hwloc_bitmap_first(pu->nodeset) : 0;
+}
+
+
+bool xmrig::VirtualMemory::membind(void *p, size_t size, uint32_t node)
+{
+    if (p == nullptr || Cpu::info()->nodes() < 2) {
+        return false;
+    }
+
+    auto obj = hwloc_get_numanode_obj_by_os_index(Cpu::info()->topology(), node);
+    if (obj == nullptr) {
+        return false;
+    }
+
+    // Pages which are already touched are moved to the node
+#   if HWLOC_API_VERSION >= 0x20000
+    return hwloc_set_area_membind(Cpu::info()->topology(), p, size, obj->nodeset, HWLOC_MEMBIND_BIND, HWLOC_MEMBIND_MIGRATE | HWLOC_MEMBIND_BYNODESET) >= 0;
+#   else
+    return hwloc_set_area_membind_nodeset(Cpu::info()->topology(), p, size, obj->nodeset, HWLOC_MEMBIND_BIND, HWLOC_MEMBIND_MIGRATE) >= 0;
+#   endif
+}
+
+
+int64_t xmrig::VirtualMemory::nodeOf(const void *p, size_t size)
+{
+#   if HWLOC_API_VERSION >= 0x20000
+    if (p == nullptr) {
+        return -1;
+    }
+
+    hwloc_bitmap_t nodeset = hwloc_bitmap_alloc();
+    int64_t node           = -1;
+
+    if (hwloc_get_area_memlocation(Cpu::info()->topology(), p, size, nodeset, HWLOC_MEMBIND_BYNODESET) == 0 && hwloc_bitmap_weight(nodeset) == 1) {
+        node = hwloc_bitmap_first(nodeset);
+    }
+
+    hwloc_bitmap_free(nodeset);
+
+    return node;
+#   else
+    return -1;
+#   endif
+}
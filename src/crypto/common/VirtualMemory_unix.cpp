@@ -23,8 +23,10 @@
 
 
 #include <cmath>
+#include <cstdio>
 #include <cstdlib>
 #include <fstream>
+#include <string>
 #include <sys/mman.h>
 
 
@@ -45,6 +47,8 @@
 
 #ifdef XMRIG_OS_LINUX
 #   include "crypto/common/LinuxMemory.h"
+#   include <sys/syscall.h>
+#   include <unistd.h>
 #endif
 
 
@@ -139,6 +143,49 @@ bool xmrig::VirtualMemory::protectRX(void *p, size_t size)
 }
 
 
+void *xmrig::VirtualMemory::allocateDualMappedMemory(size_t size, void **writable)
+{
+#   if defined(XMRIG_OS_LINUX) && defined(SYS_memfd_create)
+    // memfd_create() is called directly, glibc has a wrapper only since 2.27
+    const int fd = static_cast<int>(syscall(SYS_memfd_create, "xmrig-jit", 1U /* MFD_CLOEXEC */));
+    if (fd < 0) {
+        return nullptr;
+    }
+
+    void *rx = MAP_FAILED;
+    void *rw = MAP_FAILED;
+
+    if (ftruncate(fd, static_cast<off_t>(size)) == 0) {
+        rx = mmap(0, size, PROT_READ | PROT_EXEC, MAP_SHARED, fd, 0);
+        rw = mmap(0, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+
+    close(fd);
+
+    if (rx == MAP_FAILED || rw == MAP_FAILED) {
+        if (rx != MAP_FAILED) {
+            munmap(rx, size);
+        }
+
+        if (rw != MAP_FAILED) {
+            munmap(rw, size);
+        }
+
+        return nullptr;
+    }
+
+    *writable = rw;
+
+    return rx;
+#   else
+    (void)size;
+    (void)writable;
+
+    return nullptr;
+#   endif
+}
+
+
 void *xmrig::VirtualMemory::allocateExecutableMemory(size_t size, bool hugePages)
 {
 #   if defined(XMRIG_OS_APPLE)
@@ -163,7 +210,10 @@ void *xmrig::VirtualMemory::allocateExecutableMemory(size_t size, bool hugePages
     void *mem = nullptr;
 
     if (hugePages) {
-        mem = mmap(0, align(size), PROT_READ | PROT_WRITE | SECURE_PROT_EXEC, MAP_PRIVATE | MAP_ANONYMOUS | MAP_POPULATE | hugePagesFlag(hugePageSize()), -1, 0);
+        mem = mmap(0, align(size), PROT_READ | PROT_WRITE | SECURE_PROT_EXEC, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | MAP_POPULATE | hugePagesFlag(hugePageSize()), -1, 0);
+        if (mem == MAP_FAILED) {
+            mem = nullptr;
+        }
     }
 
     if (!mem) {
@@ -206,6 +256,47 @@ void *xmrig::VirtualMemory::allocateOneGbPagesMemory(size_t size)
 }
 
 
+size_t xmrig::VirtualMemory::pageSize(const void *p)
+{
+#   ifdef XMRIG_OS_LINUX
+    std::ifstream file("/proc/self/smaps");
+    if (!file.is_open()) {
+        return 0;
+    }
+
+    const auto addr = reinterpret_cast<uintptr_t>(p);
+    bool found      = false;
+    size_t kernel   = 0;
+    std::string line;
+
+    while (std::getline(file, line)) {
+        unsigned long long start = 0;
+        unsigned long long end   = 0;
+        size_t value             = 0;
+
+        if (!found) {
+            found = sscanf(line.c_str(), "%llx-%llx ", &start, &end) == 2 && addr >= start && addr < end;
+        }
+        else if (sscanf(line.c_str(), "KernelPageSize: %zu kB", &value) == 1) {
+            kernel = value * 1024;
+        }
+        else if (sscanf(line.c_str(), "AnonHugePages: %zu kB", &value) == 1 && value > 0) {
+            return hugePageSize(); // transparent huge pages
+        }
+        else if (line.compare(0, 8, "VmFlags:") == 0) {
+            break;
+        }
+    }
+
+    return kernel;
+#   else
+    (void)p;
+
+    return 0;
+#   endif
+}
+
+
 void xmrig::VirtualMemory::flushInstructionCache(void *p, size_t size)
 {
 #   if defined(XMRIG_OS_APPLE)
@@ -216,12 +307,22 @@ void xmrig::VirtualMemory::flushInstructionCache(void *p, size_t size)
 }
 
 
-void xmrig::VirtualMemory::freeLargePagesMemory(void *p, size_t size)
+void xmrig::VirtualMemory::freeDualMappedMemory(void *p, void *writable, size_t size)
 {
+    munmap(writable, size);
     munmap(p, size);
 }
 
 
+void xmrig::VirtualMemory::freeLargePagesMemory(void *p, size_t size)
+{
+    // Huge page mappings can only be unmapped as a whole, callers may pass the requested (smaller) size
+    if (munmap(p, size) != 0) {
+        munmap(p, align(size, hugePageSize()));
+    }
+}
+
+
 void xmrig::VirtualMemory::osInit(size_t hugePageSize)
 {
     if (hugePageSize) {
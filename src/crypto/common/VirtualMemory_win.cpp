@@ -186,6 +186,38 @@ bool xmrig::VirtualMemory::protectRX(void *p, size_t size)
 }
 
 
+void *xmrig::VirtualMemory::allocateDualMappedMemory(size_t size, void **writable)
+{
+    const uint64_t size64 = size;
+    HANDLE mapping        = CreateFileMapping(INVALID_HANDLE_VALUE, nullptr, PAGE_EXECUTE_READWRITE, static_cast<DWORD>(size64 >> 32), static_cast<DWORD>(size64), nullptr);
+    if (!mapping) {
+        return nullptr;
+    }
+
+    void *rx = MapViewOfFile(mapping, FILE_MAP_READ | FILE_MAP_EXECUTE, 0, 0, size);
+    void *rw = MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, size);
+
+    // Views keep the section alive
+    CloseHandle(mapping);
+
+    if (!rx || !rw) {
+        if (rx) {
+            UnmapViewOfFile(rx);
+        }
+
+        if (rw) {
+            UnmapViewOfFile(rw);
+        }
+
+        return nullptr;
+    }
+
+    *writable = rw;
+
+    return rx;
+}
+
+
 void *xmrig::VirtualMemory::allocateExecutableMemory(size_t size, bool hugePages)
 {
     void* result = nullptr;
@@ -221,12 +253,25 @@ void *xmrig::VirtualMemory::allocateOneGbPagesMemory(size_t)
 }
 
 
+size_t xmrig::VirtualMemory::pageSize(const void *)
+{
+    return 0;
+}
+
+
 void xmrig::VirtualMemory::flushInstructionCache(void *p, size_t size)
 {
     ::FlushInstructionCache(GetCurrentProcess(), p, size);
 }
 
 
+void xmrig::VirtualMemory::freeDualMappedMemory(void *p, void *writable, size_t)
+{
+    UnmapViewOfFile(writable);
+    UnmapViewOfFile(p);
+}
+
+
 void xmrig::VirtualMemory::freeLargePagesMemory(void *p, size_t)
 {
     VirtualFree(p, 0, MEM_RELEASE);
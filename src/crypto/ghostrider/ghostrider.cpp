@@ -32,18 +32,26 @@
 #include "sph_fugue.h"
 #include "sph_shabal.h"
 #include "sph_whirlpool.h"
+#include "sph_multi.h"
 
+#include "3rdparty/rapidjson/document.h"
+#include "base/io/json/Json.h"
 #include "base/io/log/Log.h"
 #include "base/io/log/Tags.h"
+#include "base/kernel/Process.h"
 #include "base/tools/Chrono.h"
+#include "base/tools/String.h"
+#include "version.h"
 #include "backend/cpu/Cpu.h"
 #include "crypto/cn/CnHash.h"
 #include "crypto/cn/CnCtx.h"
 #include "crypto/cn/CryptoNight.h"
 #include "crypto/common/VirtualMemory.h"
 
+#include <algorithm>
 #include <thread>
 #include <atomic>
+#include <cstring>
 #include <uv.h>
 
 #ifdef XMRIG_FEATURE_HWLOC
@@ -95,6 +103,61 @@ CORE_HASH(14, whirlpool  );
 using core_hash_func = void (*)(const uint8_t* data, size_t size, uint8_t* output);
 static const core_hash_func core_hash[15] = { h0, h1, h2, h3, h4, h5, h6, h7, h8, h9, h10, h11, h12, h13, h14 };
 
+// Multi-buffer versions of the core hashes, nullptr where there is none for this CPU
+struct CoreHashMulti
+{
+    core_hash_func x4[15] = {};
+    core_hash_func x8[15] = {};
+
+    CoreHashMulti()
+    {
+#       ifdef XMRIG_FEATURE_AVX2
+        if (xmrig::Cpu::info()->has(xmrig::ICpuInfo::FLAG_AVX2)) {
+            x4[0]  = sph_blake512_4way_avx2;
+            x4[1]  = sph_bmw512_4way_avx2;
+            x4[4]  = sph_keccak512_4way_avx2;
+            x4[5]  = sph_skein512_4way_avx2;
+            x4[7]  = sph_cubehash512_4way_avx2;
+            x4[13] = sph_shabal512_4way_avx2;
+            x8[7]  = sph_cubehash512_8way_avx2;
+            x8[13] = sph_shabal512_8way_avx2;
+        }
+#       endif
+
+#       ifdef XMRIG_FEATURE_AVX512F
+        if (xmrig::Cpu::info()->has(xmrig::ICpuInfo::FLAG_AVX512F)) {
+            x8[0]  = sph_blake512_8way_avx512;
+            x8[1]  = sph_bmw512_8way_avx512;
+            x8[4]  = sph_keccak512_8way_avx512;
+            x8[5]  = sph_skein512_8way_avx512;
+        }
+#       endif
+    }
+};
+
+
+// Hashes lanes [begin, end) with core hash "index", lane j is read from data + j * size and written to output + j * 64.
+// The multi-buffer functions read all input before writing any output, so data == output is fine here.
+static void core_hash_lanes(uint32_t index, const uint8_t* data, size_t size, uint8_t* output, size_t begin, size_t end)
+{
+    static const CoreHashMulti multi;
+
+    if ((end - begin == 8) && multi.x8[index]) {
+        multi.x8[index](data + begin * size, size, output + begin * 64);
+        return;
+    }
+
+    if (multi.x4[index]) {
+        for (; begin + 4 <= end; begin += 4) {
+            multi.x4[index](data + begin * size, size, output + begin * 64);
+        }
+    }
+
+    for (; begin < end; ++begin) {
+        core_hash[index](data + begin * size, size, output + begin * 64);
+    }
+}
+
 namespace xmrig
 {
 
@@ -169,6 +232,130 @@ static struct AlgoTune
 } tuneDefault[6], tune8MB[6];
 
 
+// Tuning results are cached per CPU model and L3 size, the benchmark runs again for a new binary version
+static const char *kTuneFile    = "ghostrider.json";
+static const char *k8MB         = "8mb";
+static const char *kDefault     = "default";
+static const char *kVersion     = "version";
+
+// Set once tuneDefault and tune8MB are final, readers outside the benchmark must check it before they read the arrays
+static std::atomic<const char *> tuneSource{ nullptr };
+
+
+static String tuneKey()
+{
+    char buf[256];
+    const int size = snprintf(buf, sizeof(buf), "%s, L3 %zu KB, %zu cores", Cpu::info()->brand(), Cpu::info()->L3() >> 10, Cpu::info()->cores());
+
+    return { buf, std::min<size_t>(static_cast<size_t>(size), sizeof(buf) - 1) };
+}
+
+
+static rapidjson::Value tuneToJSON(const AlgoTune (&tune)[6], rapidjson::Document &doc)
+{
+    using namespace rapidjson;
+    auto &allocator = doc.GetAllocator();
+
+    Value out(kArrayType);
+    for (const auto &t : tune) {
+        Value item(kArrayType);
+        item.PushBack(t.step, allocator);
+        item.PushBack(t.threads, allocator);
+        item.PushBack(t.hashrate, allocator);
+
+        out.PushBack(item, allocator);
+    }
+
+    return out;
+}
+
+
+static bool tuneFromJSON(const rapidjson::Value &value, AlgoTune (&tune)[6])
+{
+    if (!value.IsArray() || value.Size() != 6) {
+        return false;
+    }
+
+    AlgoTune result[6];
+
+    for (rapidjson::SizeType i = 0; i < 6; ++i) {
+        const auto &item = value[i];
+        if (!item.IsArray() || item.Size() != 3 || !item[0].IsUint() || !item[1].IsUint() || !item[2].IsNumber()) {
+            return false;
+        }
+
+        result[i].step      = item[0].GetUint();
+        result[i].threads   = item[1].GetUint();
+        result[i].hashrate  = item[2].GetDouble();
+
+        if ((result[i].step != 1 && result[i].step != 2 && result[i].step != 4) || (result[i].threads != 1 && result[i].threads != 2)) {
+            return false;
+        }
+    }
+
+    std::copy(std::begin(result), std::end(result), tune);
+
+    return true;
+}
+
+
+#if !defined(XMRIG_ARM) && !defined(XMRIG_RISCV)
+static bool loadTune(const String &path)
+{
+    rapidjson::Document doc;
+    if (!Json::get(path, doc) || !doc.IsObject()) {
+        return false;
+    }
+
+    const auto &entry = Json::getObject(doc, tuneKey());
+    const char *version = Json::getString(entry, kVersion);
+
+    if (!version || strcmp(version, APP_VERSION) != 0) {
+        return false;
+    }
+
+    AlgoTune tuneDefaultCached[6];
+    AlgoTune tune8MBCached[6];
+
+    if (!tuneFromJSON(Json::getArray(entry, kDefault), tuneDefaultCached) || !tuneFromJSON(Json::getArray(entry, k8MB), tune8MBCached)) {
+        return false;
+    }
+
+    std::copy(std::begin(tuneDefaultCached), std::end(tuneDefaultCached), tuneDefault);
+    std::copy(std::begin(tune8MBCached), std::end(tune8MBCached), tune8MB);
+
+    return true;
+}
+
+
+static void saveTune(const String &path)
+{
+    using namespace rapidjson;
+
+    // Other entries are kept, a data directory can be shared by different machines
+    Document doc;
+    if (!Json::get(path, doc) || !doc.IsObject()) {
+        doc.SetObject();
+    }
+
+    auto &allocator = doc.GetAllocator();
+    const String key = tuneKey();
+
+    Value entry(kObjectType);
+    entry.AddMember(StringRef(kVersion), APP_VERSION, allocator);
+    entry.AddMember(StringRef(kDefault), tuneToJSON(tuneDefault, doc), allocator);
+    entry.AddMember(StringRef(k8MB), tuneToJSON(tune8MB, doc), allocator);
+
+    doc.RemoveMember(key.data());
+    doc.AddMember(key.toJSON(doc), entry, allocator);
+
+    if (Json::save(path, doc)) {
+        LOG_VERBOSE("GhostRider tuning results saved to %s", path.data());
+    }
+}
+#endif
+
+
 struct HelperThread
 {
     XMRIG_DISABLE_COPY_MOVE_DEFAULT(HelperThread)
@@ -177,6 +364,7 @@ struct HelperThread
     {
         uv_mutex_init(&m_mutex);
         uv_cond_init(&m_cond);
+        uv_cond_init(&m_idle);
 
         m_thread = new std::thread(&HelperThread::run, this);
         do {
@@ -196,6 +384,7 @@ struct HelperThread
 
         uv_mutex_destroy(&m_mutex);
         uv_cond_destroy(&m_cond);
+        uv_cond_destroy(&m_idle);
 
         hwloc_bitmap_free(m_cpuSet);
     }
@@ -235,11 +424,20 @@ struct HelperThread
         uv_mutex_unlock(&m_mutex);
     }
 
-    inline void wait() const
+    // Spins only for a short while, the rest of the time the caller sleeps until the tasks are done
+    inline void wait()
     {
-        while (m_numTasks) {
+        for (uint32_t i = 0; m_numTasks && (i < kSpinCount); ++i) {
             _mm_pause();
         }
+
+        if (m_numTasks) {
+            uv_mutex_lock(&m_mutex);
+            while (m_numTasks) {
+                uv_cond_wait(&m_idle, &m_mutex);
+            }
+            uv_mutex_unlock(&m_mutex);
+        }
     }
 
     void run()
@@ -266,14 +464,18 @@ struct HelperThread
                 }
                 std::atomic_thread_fence(std::memory_order_seq_cst);
                 m_numTasks = 0;
+                uv_cond_signal(&m_idle);
             }
         } while (!m_finished);
 
         uv_mutex_unlock(&m_mutex);
     }
 
+    static constexpr uint32_t kSpinCount = 4096;
+
     uv_mutex_t m_mutex;
     uv_cond_t m_cond;
+    uv_cond_t m_idle;
 
     alignas(16) uint8_t m_tasks[4][128] = {};
     volatile uint32_t m_numTasks = 0;
@@ -287,164 +489,180 @@ struct HelperThread
 };
 
 
-void benchmark()
-{
 #if !defined(XMRIG_ARM) && !defined(XMRIG_RISCV)
-    static std::atomic<int> done{ 0 };
-    if (done.exchange(1)) {
-        return;
-    }
-
-    std::thread t([]() {
-        // Try to avoid CPU core 0 because many system threads use it and can interfere
-        uint32_t thread_index1 = (Cpu::info()->threads() > 2) ? 2 : 0;
+static void run_benchmark()
+{
+    // Try to avoid CPU core 0 because many system threads use it and can interfere
+    uint32_t thread_index1 = (Cpu::info()->threads() > 2) ? 2 : 0;
 
-        hwloc_topology_t topology = Cpu::info()->topology();
-        hwloc_obj_t pu = hwloc_get_pu_obj_by_os_index(topology, thread_index1);
-        hwloc_obj_t pu2 = nullptr;
-        hwloc_get_closest_objs(topology, pu, &pu2, 1);
-        uint32_t thread_index2 = pu2 ? pu2->os_index : thread_index1;
+    hwloc_topology_t topology = Cpu::info()->topology();
+    hwloc_obj_t pu = hwloc_get_pu_obj_by_os_index(topology, thread_index1);
+    hwloc_obj_t pu2 = nullptr;
+    hwloc_get_closest_objs(topology, pu, &pu2, 1);
+    uint32_t thread_index2 = pu2 ? pu2->os_index : thread_index1;
 
-        if (thread_index2 < thread_index1) {
-            std::swap(thread_index1, thread_index2);
-        }
+    if (thread_index2 < thread_index1) {
+        std::swap(thread_index1, thread_index2);
+    }
 
-        Platform::setThreadAffinity(thread_index1);
-        Platform::setThreadPriority(3);
+    Platform::setThreadAffinity(thread_index1);
+    Platform::setThreadPriority(3);
 
-        constexpr uint32_t N = 1U << 21;
+    constexpr uint32_t N = 1U << 21;
 
-        VirtualMemory::init(0, N);
-        VirtualMemory* memory = new VirtualMemory(N * 8, true, false, false);
+    VirtualMemory::init(0, N);
+    VirtualMemory* memory = new VirtualMemory(N * 8, true, false, false);
 
-        // 2 MB cache per core by default
-        size_t max_scratchpad_size = 1U << 21;
+    // 2 MB cache per core by default
+    size_t max_scratchpad_size = 1U << 21;
 
-        if ((Cpu::info()->L3() >> 22) > Cpu::info()->cores()) {
-            // At least 1 core can run with 8 MB cache
-            max_scratchpad_size = 1U << 23;
-        }
-        else if ((Cpu::info()->L3() >> 22) >= Cpu::info()->cores()) {
-            // All cores can run with 4 MB cache
-            max_scratchpad_size = 1U << 22;
-        }
+    if ((Cpu::info()->L3() >> 22) > Cpu::info()->cores()) {
+        // At least 1 core can run with 8 MB cache
+        max_scratchpad_size = 1U << 23;
+    }
+    else if ((Cpu::info()->L3() >> 22) >= Cpu::info()->cores()) {
+        // All cores can run with 4 MB cache
+        max_scratchpad_size = 1U << 22;
+    }
 
-        LOG_VERBOSE("Running GhostRider benchmark on logical CPUs %u and %u (max scratchpad size %zu MB, huge pages %s)", thread_index1, thread_index2, max_scratchpad_size >> 20, memory->isHugePages() ? "on" : "off");
+    LOG_VERBOSE("Running GhostRider benchmark on logical CPUs %u and %u (max scratchpad size %zu MB, huge pages %s)", thread_index1, thread_index2, max_scratchpad_size >> 20, memory->isHugePages() ? "on" : "off");
 
-        cryptonight_ctx* ctx[8];
-        CnCtx::create(ctx, memory->scratchpad(), N, 8);
+    cryptonight_ctx* ctx[8];
+    CnCtx::create(ctx, memory->scratchpad(), N, 8);
 
-        const CnHash::AlgoVariant* av = Cpu::info()->hasAES() ? av_hw_aes : av_soft_aes;
+    const CnHash::AlgoVariant* av = Cpu::info()->hasAES() ? av_hw_aes : av_soft_aes;
 
-        uint8_t buf[80];
-        uint8_t hash[32 * 8];
+    uint8_t buf[80];
+    uint8_t hash[32 * 8];
 
-        LOG_VERBOSE("%24s |  N  | Hashrate", "Algorithm");
-        LOG_VERBOSE("-------------------------|-----|-------------");
+    LOG_VERBOSE("%24s |  N  | Hashrate", "Algorithm");
+    LOG_VERBOSE("-------------------------|-----|-------------");
 
-        for (uint32_t algo = 0; algo < 6; ++algo) {
-            for (uint64_t step : { 1, 2, 4}) {
-                const size_t cur_scratchpad_size = cn_sizes[algo] * step;
-                if (cur_scratchpad_size > max_scratchpad_size) {
-                    continue;
-                }
+    for (uint32_t algo = 0; algo < 6; ++algo) {
+        for (uint64_t step : { 1, 2, 4}) {
+            const size_t cur_scratchpad_size = cn_sizes[algo] * step;
+            if (cur_scratchpad_size > max_scratchpad_size) {
+                continue;
+            }
 
-                auto f = CnHash::fn(cn_hash[algo], av[step], Assembly::AUTO);
+            auto f = CnHash::fn(cn_hash[algo], av[step], Assembly::AUTO);
 
-                double start_time = Chrono::highResolutionMSecs();
+            double start_time = Chrono::highResolutionMSecs();
 
-                double min_dt = 1e10;
-                for (uint32_t iter = 0;; ++iter) {
-                    double t1 = Chrono::highResolutionMSecs();
+            double min_dt = 1e10;
+            for (uint32_t iter = 0;; ++iter) {
+                double t1 = Chrono::highResolutionMSecs();
 
-                    // Stop after 15 milliseconds, but only if at least 10 iterations were done
-                    if ((iter >= 10) && (t1 - start_time >= 15.0)) {
-                        break;
-                    }
+                // Stop after 15 milliseconds, but only if at least 10 iterations were done
+                if ((iter >= 10) && (t1 - start_time >= 15.0)) {
+                    break;
+                }
 
-                    f(buf, sizeof(buf), hash, ctx, 0);
+                f(buf, sizeof(buf), hash, ctx, 0);
 
-                    const double dt = Chrono::highResolutionMSecs() - t1;
-                    if (dt < min_dt) {
-                        min_dt = dt;
-                    }
+                const double dt = Chrono::highResolutionMSecs() - t1;
+                if (dt < min_dt) {
+                    min_dt = dt;
                 }
+            }
 
-                const double hashrate = step * 1e3 / min_dt;
-                LOG_VERBOSE("%24s | %" PRIu64 "x1 | %.2f h/s", cn_names[algo], step, hashrate);
+            const double hashrate = step * 1e3 / min_dt;
+            LOG_VERBOSE("%24s | %" PRIu64 "x1 | %.2f h/s", cn_names[algo], step, hashrate);
 
-                if (hashrate > tune8MB[algo].hashrate) {
-                    tune8MB[algo].hashrate = hashrate;
-                    tune8MB[algo].step = static_cast<uint32_t>(step);
-                    tune8MB[algo].threads = 1;
-                }
+            if (hashrate > tune8MB[algo].hashrate) {
+                tune8MB[algo].hashrate = hashrate;
+                tune8MB[algo].step = static_cast<uint32_t>(step);
+                tune8MB[algo].threads = 1;
+            }
 
-                if ((cur_scratchpad_size < (1U << 23)) && (hashrate > tuneDefault[algo].hashrate)) {
-                    tuneDefault[algo].hashrate = hashrate;
-                    tuneDefault[algo].step = static_cast<uint32_t>(step);
-                    tuneDefault[algo].threads = 1;
-                }
+            if ((cur_scratchpad_size < (1U << 23)) && (hashrate > tuneDefault[algo].hashrate)) {
+                tuneDefault[algo].hashrate = hashrate;
+                tuneDefault[algo].step = static_cast<uint32_t>(step);
+                tuneDefault[algo].threads = 1;
             }
         }
+    }
 
-        hwloc_bitmap_t helper_set = hwloc_bitmap_alloc();
-        hwloc_bitmap_set(helper_set, thread_index2);
-        HelperThread* helper = new HelperThread(helper_set, 3, false);
+    hwloc_bitmap_t helper_set = hwloc_bitmap_alloc();
+    hwloc_bitmap_set(helper_set, thread_index2);
+    HelperThread* helper = new HelperThread(helper_set, 3, false);
 
-        for (uint32_t algo = 0; algo < 6; ++algo) {
-            for (uint64_t step : { 1, 2, 4}) {
-                const size_t cur_scratchpad_size = cn_sizes[algo] * step * 2;
-                if (cur_scratchpad_size > max_scratchpad_size) {
-                    continue;
-                }
+    for (uint32_t algo = 0; algo < 6; ++algo) {
+        for (uint64_t step : { 1, 2, 4}) {
+            const size_t cur_scratchpad_size = cn_sizes[algo] * step * 2;
+            if (cur_scratchpad_size > max_scratchpad_size) {
+                continue;
+            }
 
-                auto f = CnHash::fn(cn_hash[algo], av[step], Assembly::AUTO);
+            auto f = CnHash::fn(cn_hash[algo], av[step], Assembly::AUTO);
 
-                double start_time = Chrono::highResolutionMSecs();
+            double start_time = Chrono::highResolutionMSecs();
 
-                double min_dt = 1e10;
-                for (uint32_t iter = 0;; ++iter) {
-                    double t1 = Chrono::highResolutionMSecs();
+            double min_dt = 1e10;
+            for (uint32_t iter = 0;; ++iter) {
+                double t1 = Chrono::highResolutionMSecs();
 
-                    // Stop after 30 milliseconds, but only if at least 10 iterations were done
-                    if ((iter >= 10) && (t1 - start_time >= 30.0)) {
-                        break;
-                    }
+                // Stop after 30 milliseconds, but only if at least 10 iterations were done
+                if ((iter >= 10) && (t1 - start_time >= 30.0)) {
+                    break;
+                }
 
-                    helper->launch_task([&f, &buf, &hash, &ctx, &step]() { f(buf, sizeof(buf), hash + step * 32, ctx + step, 0); });
-                    f(buf, sizeof(buf), hash, ctx, 0);
-                    helper->wait();
+                helper->launch_task([&f, &buf, &hash, &ctx, &step]() { f(buf, sizeof(buf), hash + step * 32, ctx + step, 0); });
+                f(buf, sizeof(buf), hash, ctx, 0);
+                helper->wait();
 
-                    const double dt = Chrono::highResolutionMSecs() - t1;
-                    if (dt < min_dt) {
-                        min_dt = dt;
-                    }
+                const double dt = Chrono::highResolutionMSecs() - t1;
+                if (dt < min_dt) {
+                    min_dt = dt;
                 }
+            }
 
-                const double hashrate = step * 2e3 / min_dt * 1.0075;
-                LOG_VERBOSE("%24s | %" PRIu64 "x2 | %.2f h/s", cn_names[algo], step, hashrate);
+            const double hashrate = step * 2e3 / min_dt * 1.0075;
+            LOG_VERBOSE("%24s | %" PRIu64 "x2 | %.2f h/s", cn_names[algo], step, hashrate);
 
-                if (hashrate > tune8MB[algo].hashrate) {
-                    tune8MB[algo].hashrate = hashrate;
-                    tune8MB[algo].step = static_cast<uint32_t>(step);
-                    tune8MB[algo].threads = 2;
-                }
+            if (hashrate > tune8MB[algo].hashrate) {
+                tune8MB[algo].hashrate = hashrate;
+                tune8MB[algo].step = static_cast<uint32_t>(step);
+                tune8MB[algo].threads = 2;
+            }
 
-                if ((cur_scratchpad_size < (1U << 23)) && (hashrate > tuneDefault[algo].hashrate)) {
-                    tuneDefault[algo].hashrate = hashrate;
-                    tuneDefault[algo].step = static_cast<uint32_t>(step);
-                    tuneDefault[algo].threads = 2;
-                }
+            if ((cur_scratchpad_size < (1U << 23)) && (hashrate > tuneDefault[algo].hashrate)) {
+                tuneDefault[algo].hashrate = hashrate;
+                tuneDefault[algo].step = static_cast<uint32_t>(step);
+                tuneDefault[algo].threads = 2;
             }
         }
+    }
+
+    delete helper;
+
+    CnCtx::release(ctx, 8);
+    delete memory;
+}
+#endif
+
+
+void benchmark()
+{
+#if !defined(XMRIG_ARM) && !defined(XMRIG_RISCV)
+    static std::atomic<int> done{ 0 };
+    if (done.exchange(1)) {
+        return;
+    }
 
-        delete helper;
+    const String path = Process::location(Process::DataLocation, kTuneFile);
 
-        CnCtx::release(ctx, 8);
-        delete memory;
-    });
+    if (loadTune(path)) {
+        LOG_INFO("%s " WHITE_BOLD("GhostRider") " use cached tuning results from " CYAN_BOLD("%s"), Tags::cpu(), path.data());
+        tuneSource.store("cache", std::memory_order_release);
+    }
+    else {
+        std::thread t(run_benchmark);
+        t.join();
 
-    t.join();
+        tuneSource.store("benchmark", std::memory_order_release);
+        saveTune(path);
+    }
 
     LOG_VERBOSE("---------------------------------------------");
     LOG_VERBOSE("|         GhostRider tuning results         |");
@@ -460,6 +678,40 @@ void benchmark()
 }
 
 
+void tune_to_json(rapidjson::Value &out, rapidjson::Document &doc)
+{
+    using namespace rapidjson;
+    auto &allocator = doc.GetAllocator();
+
+    // The benchmark may still be writing the tune arrays until the source is published
+    const char *source = tuneSource.load(std::memory_order_acquire);
+
+    out.SetObject();
+    out.AddMember("source", source ? Value(StringRef(source)) : Value(kNullType), allocator);
+    out.AddMember("cpu", tuneKey().toJSON(doc), allocator);
+
+    Value algorithms(kArrayType);
+
+    for (size_t algo = 0; source && algo < 6; ++algo) {
+        Value item(kObjectType);
+        item.AddMember("algo", StringRef(cn_names[algo]), allocator);
+
+        for (const auto &t : { std::make_pair(kDefault, &tuneDefault[algo]), std::make_pair(k8MB, &tune8MB[algo]) }) {
+            Value tune(kObjectType);
+            tune.AddMember("step",      t.second->step, allocator);
+            tune.AddMember("threads",   t.second->threads, allocator);
+            tune.AddMember("hashrate",  t.second->hashrate, allocator);
+
+            item.AddMember(StringRef(t.first), tune, allocator);
+        }
+
+        algorithms.PushBack(item, allocator);
+    }
+
+    out.AddMember("algorithms", algorithms, allocator);
+}
+
+
 template <typename func>
 static inline bool findByType(hwloc_obj_t obj, hwloc_obj_type_t type, func lambda)
 {
@@ -559,223 +811,240 @@ void destroy_helper_thread(HelperThread* t)
 }
 
 
-void hash_octa(const uint8_t* data, size_t size, uint8_t* output, cryptonight_ctx** ctx, HelperThread* helper, bool verbose)
+// Splits the work of hash_octa() between the worker thread and its helper thread.
+//
+// A unit is one CN part of a group of "step" lanes together with the 5 core hashes before it. Each unit becomes ready
+// as soon as all its lanes are done with the previous part, so a thread which runs out of work in one part can start
+// the next part instead of waiting. Parts tuned to run on 1 thread are exclusive: only the worker thread runs them and
+// never together with the helper. Threads with nothing to do sleep on a condition variable instead of spinning.
+class OctaScheduler
 {
+public:
+    XMRIG_DISABLE_COPY_MOVE_DEFAULT(OctaScheduler)
+
     enum { N = 8 };
 
-    uint8_t* ctx_memory[N];
-    for (size_t i = 0; i < N; ++i) {
-        ctx_memory[i] = ctx[i]->memory;
-    }
+    struct Unit
+    {
+        uint32_t part;
+        uint32_t first;
+        uint32_t step;
+        bool exclusive;
+    };
 
-    // PrevBlockHash (GhostRider's seed) is stored in bytes [4; 36)
-    uint32_t core_indices[15];
-    select_indices(core_indices, data + 4);
+    OctaScheduler(const AlgoTune* tune, const uint32_t* cn_indices, bool hasHelper) : m_helperActive(hasHelper)
+    {
+        uv_mutex_init(&m_mutex);
+        uv_cond_init(&m_cond);
 
-    uint32_t cn_indices[6];
-    select_indices(cn_indices, data + 4);
+        for (uint32_t part = 0; part < 3; ++part) {
+            const AlgoTune& t = tune[cn_indices[part]];
 
-    if (verbose) {
-        static uint32_t prev_indices[3];
-        if (memcmp(cn_indices, prev_indices, sizeof(prev_indices)) != 0) {
-            memcpy(prev_indices, cn_indices, sizeof(prev_indices));
-            for (int i = 0; i < 3; ++i) {
-                LOG_INFO("%s GhostRider algo %d: %s", Tags::cpu(), i + 1, cn_names[cn_indices[i]]);
+            for (uint32_t j = 0; j < N; j += t.step) {
+                m_units[m_numUnits++] = { part, j, t.step, !hasHelper || (t.threads != 2) };
             }
         }
     }
 
-    const CnHash::AlgoVariant* av = Cpu::info()->hasAES() ? av_hw_aes : av_soft_aes;
-    const AlgoTune* tune = (helper && helper->m_is8MB) ? tune8MB : tuneDefault;
+    ~OctaScheduler()
+    {
+        uv_mutex_destroy(&m_mutex);
+        uv_cond_destroy(&m_cond);
+    }
 
-    uint8_t tmp[64 * N];
+    // Blocks until a unit is available for this thread, returns false when there is nothing left for it
+    bool next(bool isHelper, Unit& unit)
+    {
+        uv_mutex_lock(&m_mutex);
 
-    if (helper && (tune[cn_indices[0]].threads == 2) && (tune[cn_indices[1]].threads == 2) && (tune[cn_indices[2]].threads == 2)) {
-        constexpr size_t n = N / 2;
+        if (m_current[isHelper]) {
+            complete(*m_current[isHelper]);
+            m_current[isHelper] = nullptr;
+        }
 
-        helper->launch_task([av, data, size, &ctx_memory, ctx, &cn_indices, &core_indices, &tmp, output, tune]() {
-#           ifdef _MSC_VER
-            constexpr size_t n = N / 2;
-#           endif
+        bool result = false;
 
-            const uint8_t* input = data;
-            size_t input_size = size;
+        for (;;) {
+            bool pending  = false;
+            bool waitExcl = false;
 
-            for (size_t part = 0; part < 3; ++part) {
-                const AlgoTune& t = tune[cn_indices[part]];
+            for (uint32_t i = 0; i < m_numUnits; ++i) {
+                const Unit& u = m_units[i];
+                if (m_claimed[i] || (isHelper && u.exclusive)) {
+                    continue;
+                }
 
-                // Allocate scratchpads
-                {
-                    uint8_t* p = ctx_memory[4];
+                pending = true;
 
-                    for (size_t i = n, k = 4; i < N; ++i) {
-                        if ((i % t.step) == 0) {
-                            k = 4;
-                            p = ctx_memory[4];
-                        }
-                        else if (p - ctx_memory[k] >= (1 << 21)) {
-                            ++k;
-                            p = ctx_memory[k];
-                        }
-                        ctx[i]->memory = p;
-                        p += cn_sizes[cn_indices[part]];
-                    }
+                if (!isReady(u)) {
+                    continue;
                 }
 
-                for (size_t i = 0; i < 5; ++i) {
-                    for (size_t j = n; j < N; ++j) {
-                        core_hash[core_indices[part * 5 + i]](input + j * input_size, input_size, tmp + j * 64);
-                    }
-                    input = tmp;
-                    input_size = 64;
+                if (u.exclusive ? (m_current[1] != nullptr) : (isHelper && (m_exclusive || m_exclusiveWait))) {
+                    waitExcl = waitExcl || u.exclusive;
+                    continue;
                 }
 
-                auto f = CnHash::fn(cn_hash[cn_indices[part]], av[t.step], Assembly::AUTO);
-                for (size_t j = n; j < N; j += t.step) {
-                    f(tmp + j * 64, 64, output + j * 32, ctx + n, 0);
-                }
+                m_claimed[i]          = true;
+                m_current[isHelper]   = &u;
+                m_exclusive           = u.exclusive;
+                m_exclusiveWait       = false;
+                unit                  = u;
+                result                = true;
+                break;
+            }
 
-                for (size_t j = n; j < N; ++j) {
-                    memcpy(tmp + j * 64, output + j * 32, 32);
-                    memset(tmp + j * 64 + 32, 0, 32);
-                }
+            if (result || !pending) {
+                break;
             }
-        });
 
-        const uint8_t* input = data;
-        size_t input_size = size;
+            m_exclusiveWait = m_exclusiveWait || waitExcl;
+            uv_cond_wait(&m_cond, &m_mutex);
+        }
 
-        for (size_t part = 0; part < 3; ++part) {
-            const AlgoTune& t = tune[cn_indices[part]];
+        if (!result && isHelper) {
+            m_helperActive = false;
+            uv_cond_broadcast(&m_cond);
+        }
 
-            // Allocate scratchpads
-            {
-                uint8_t* p = ctx_memory[0];
+        uv_mutex_unlock(&m_mutex);
+        return result;
+    }
 
-                for (size_t i = 0, k = 0; i < n; ++i) {
-                    if ((i % t.step) == 0) {
-                        k = 0;
-                        p = ctx_memory[0];
-                    }
-                    else if (p - ctx_memory[k] >= (1 << 21)) {
-                        ++k;
-                        p = ctx_memory[k];
-                    }
-                    ctx[i]->memory = p;
-                    p += cn_sizes[cn_indices[part]];
-                }
-            }
+    // The helper task uses this object, so the worker thread must not leave hash_octa() before it's done
+    void waitHelper()
+    {
+        uv_mutex_lock(&m_mutex);
+        while (m_helperActive) {
+            uv_cond_wait(&m_cond, &m_mutex);
+        }
+        uv_mutex_unlock(&m_mutex);
+    }
 
-            for (size_t i = 0; i < 5; ++i) {
-                for (size_t j = 0; j < n; ++j) {
-                    core_hash[core_indices[part * 5 + i]](input + j * input_size, input_size, tmp + j * 64);
-                }
-                input = tmp;
-                input_size = 64;
+private:
+    inline bool isReady(const Unit& u) const
+    {
+        for (uint32_t i = u.first; i < u.first + u.step; ++i) {
+            if (m_lanePart[i] != u.part) {
+                return false;
             }
+        }
 
-            auto f = CnHash::fn(cn_hash[cn_indices[part]], av[t.step], Assembly::AUTO);
-            for (size_t j = 0; j < n; j += t.step) {
-                f(tmp + j * 64, 64, output + j * 32, ctx, 0);
-            }
+        return true;
+    }
 
-            for (size_t j = 0; j < n; ++j) {
-                memcpy(tmp + j * 64, output + j * 32, 32);
-                memset(tmp + j * 64 + 32, 0, 32);
-            }
+    inline void complete(const Unit& u)
+    {
+        for (uint32_t i = u.first; i < u.first + u.step; ++i) {
+            ++m_lanePart[i];
         }
 
-        helper->wait();
+        if (u.exclusive) {
+            m_exclusive = false;
+        }
+
+        uv_cond_broadcast(&m_cond);
     }
-    else {
-        for (size_t part = 0; part < 3; ++part) {
-            const AlgoTune& t = tune[cn_indices[part]];
 
-            // Allocate scratchpads
-            {
-                uint8_t* p = ctx_memory[0];
-                const size_t n = N / t.threads;
+    bool m_claimed[3 * N]       = {};
+    bool m_exclusive            = false;
+    bool m_exclusiveWait        = false;
+    bool m_helperActive         = false;
+    const Unit* m_current[2]    = {};
+    uint32_t m_lanePart[N]      = {};
+    uint32_t m_numUnits         = 0;
+    Unit m_units[3 * N]         = {};
+    uv_cond_t m_cond;
+    uv_mutex_t m_mutex;
+};
 
-                // Thread 1
-                for (size_t i = 0, k = 0; i < n; ++i) {
-                    if ((i % t.step) == 0) {
-                        k = 0;
-                        p = ctx_memory[0];
-                    }
-                    else if (p - ctx_memory[k] >= (1 << 21)) {
-                        ++k;
-                        p = ctx_memory[k];
-                    }
-                    ctx[i]->memory = p;
-                    p += cn_sizes[cn_indices[part]];
-                }
 
-                // Thread 2
-                for (size_t i = n, k = 4; i < N; ++i) {
-                    if ((i % t.step) == 0) {
-                        k = 4;
-                        p = ctx_memory[4];
-                    }
-                    else if (p - ctx_memory[k] >= (1 << 21)) {
-                        ++k;
-                        p = ctx_memory[k];
-                    }
-                    ctx[i]->memory = p;
-                    p += cn_sizes[cn_indices[part]];
-                }
-            }
+void hash_octa(const uint8_t* data, size_t size, uint8_t* output, cryptonight_ctx** ctx, HelperThread* helper, bool verbose)
+{
+    enum { N = 8 };
 
-            size_t n = N;
+    uint8_t* ctx_memory[N];
+    for (size_t i = 0; i < N; ++i) {
+        ctx_memory[i] = ctx[i]->memory;
+    }
 
-            if (helper && (t.threads == 2)) {
-                n = N / 2;
+    // PrevBlockHash (GhostRider's seed) is stored in bytes [4; 36)
+    uint32_t core_indices[15];
+    select_indices(core_indices, data + 4);
 
-                helper->launch_task([data, size, n, &cn_indices, &core_indices, part, &tmp, av, &t, output, ctx]() {
-                    const uint8_t* input = data;
-                    size_t input_size = size;
+    uint32_t cn_indices[6];
+    select_indices(cn_indices, data + 4);
 
-                    for (size_t i = 0; i < 5; ++i) {
-                        for (size_t j = n; j < N; ++j) {
-                            core_hash[core_indices[part * 5 + i]](input + j * input_size, input_size, tmp + j * 64);
-                        }
-                        input = tmp;
-                        input_size = 64;
-                    }
+    if (verbose) {
+        static uint32_t prev_indices[3];
+        if (memcmp(cn_indices, prev_indices, sizeof(prev_indices)) != 0) {
+            memcpy(prev_indices, cn_indices, sizeof(prev_indices));
+            for (int i = 0; i < 3; ++i) {
+                LOG_INFO("%s GhostRider algo %d: %s", Tags::cpu(), i + 1, cn_names[cn_indices[i]]);
+            }
+        }
+    }
 
-                    auto f = CnHash::fn(cn_hash[cn_indices[part]], av[t.step], Assembly::AUTO);
-                    for (size_t j = n; j < N; j += t.step) {
-                        f(tmp + j * 64, 64, output + j * 32, ctx + n, 0);
-                    }
+    const CnHash::AlgoVariant* av = Cpu::info()->hasAES() ? av_hw_aes : av_soft_aes;
+    const AlgoTune* tune = (helper && helper->m_is8MB) ? tune8MB : tuneDefault;
 
-                    for (size_t j = n; j < N; ++j) {
-                        memcpy(tmp + j * 64, output + j * 32, 32);
-                        memset(tmp + j * 64 + 32, 0, 32);
-                    }
-                });
-            }
+    uint8_t tmp[64 * N];
 
-            for (size_t i = 0; i < 5; ++i) {
-                for (size_t j = 0; j < n; ++j) {
-                    core_hash[core_indices[part * 5 + i]](data + j * size, size, tmp + j * 64);
+    // The worker thread keeps its scratchpads in ctx_memory[0..3], the helper thread in ctx_memory[4..7]
+    auto process = [data, size, output, ctx, av, &ctx_memory, &cn_indices, &core_indices, &tmp](const OctaScheduler::Unit& u, size_t slot) {
+        const uint32_t cn = cn_indices[u.part];
+        const size_t end  = u.first + u.step;
+
+        // Allocate scratchpads
+        {
+            uint8_t* p = ctx_memory[slot];
+
+            for (size_t i = u.first, k = slot; i < end; ++i) {
+                if (p - ctx_memory[k] >= (1 << 21)) {
+                    ++k;
+                    p = ctx_memory[k];
                 }
-                data = tmp;
-                size = 64;
+                ctx[i]->memory = p;
+                p += cn_sizes[cn];
             }
+        }
 
-            auto f = CnHash::fn(cn_hash[cn_indices[part]], av[t.step], Assembly::AUTO);
-            for (size_t j = 0; j < n; j += t.step) {
-                f(tmp + j * 64, 64, output + j * 32, ctx, 0);
-            }
+        const uint8_t* input = (u.part == 0) ? data : tmp;
+        size_t input_size = (u.part == 0) ? size : 64;
 
-            for (size_t j = 0; j < n; ++j) {
-                memcpy(tmp + j * 64, output + j * 32, 32);
-                memset(tmp + j * 64 + 32, 0, 32);
-            }
+        for (size_t i = 0; i < 5; ++i) {
+            core_hash_lanes(core_indices[u.part * 5 + i], input, input_size, tmp, u.first, end);
+            input = tmp;
+            input_size = 64;
+        }
 
-            if (helper && (t.threads == 2)) {
-                helper->wait();
-            }
+        auto f = CnHash::fn(cn_hash[cn], av[u.step], Assembly::AUTO);
+        f(tmp + u.first * 64, 64, output + u.first * 32, ctx + u.first, 0);
+
+        for (size_t j = u.first; j < end; ++j) {
+            memcpy(tmp + j * 64, output + j * 32, 32);
+            memset(tmp + j * 64 + 32, 0, 32);
         }
+    };
+
+    OctaScheduler scheduler(tune, cn_indices, helper != nullptr);
+    OctaScheduler::Unit unit;
+
+    if (helper) {
+        helper->launch_task([&scheduler, &process]() {
+            OctaScheduler::Unit unit;
+            while (scheduler.next(true, unit)) {
+                process(unit, 4);
+            }
+        });
+    }
+
+    while (scheduler.next(false, unit)) {
+        process(unit, 0);
+    }
+
+    if (helper) {
+        scheduler.waitHelper();
     }
 
     for (size_t i = 0; i < N; ++i) {
@@ -788,6 +1057,7 @@ void hash_octa(const uint8_t* data, size_t size, uint8_t* output, cryptonight_ct
 
 
 void benchmark() {}
+void tune_to_json(rapidjson::Value &out, rapidjson::Document &) { out.SetObject(); }
 HelperThread* create_helper_thread(int64_t, int, const std::vector<int64_t>&) { return nullptr; }
 void destroy_helper_thread(HelperThread*) {}
 
@@ -851,9 +1121,7 @@ void hash_octa(const uint8_t* data, size_t size, uint8_t* output, cryptonight_ct
         }
 
         for (size_t i = 0; i < 5; ++i) {
-            for (size_t j = 0; j < N; ++j) {
-                core_hash[core_indices[part * 5 + i]](data + j * size, size, tmp + j * 64);
-            }
+            core_hash_lanes(core_indices[part * 5 + i], data, size, tmp, 0, N);
             data = tmp;
             size = 64;
         }
@@ -25,6 +25,9 @@
 #include <vector>
 
 
+#include "3rdparty/rapidjson/fwd.h"
+
+
 struct cryptonight_ctx;
 
 
@@ -39,6 +42,7 @@ namespace ghostrider
 struct HelperThread;
 
 void benchmark();
+void tune_to_json(rapidjson::Value &out, rapidjson::Document &doc);
 HelperThread* create_helper_thread(int64_t cpu_index, int priority, const std::vector<int64_t>& affinities);
 void destroy_helper_thread(HelperThread* t);
 void hash_octa(const uint8_t* data, size_t size, uint8_t* output, cryptonight_ctx** ctx, HelperThread* helper, bool verbose = true);
@@ -0,0 +1,59 @@
+/* XMRig
+ * Copyright 2018-2023 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2023 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Multi-buffer versions of the GhostRider core hashes.
+ *
+ * Every function hashes N messages of the same length at once, message k is read from
+ * data + k * size and its 64-byte digest is written to output + k * 64, which is exactly
+ * the layout of the per-lane loops in hash_octa(). Results are bit-identical to sph_*512.
+ */
+
+#ifndef SPH_MULTI_H__
+#define SPH_MULTI_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(XMRIG_FEATURE_AVX2)
+void sph_blake512_4way_avx2(const uint8_t* data, size_t size, uint8_t* output);
+void sph_bmw512_4way_avx2(const uint8_t* data, size_t size, uint8_t* output);
+void sph_keccak512_4way_avx2(const uint8_t* data, size_t size, uint8_t* output);
+void sph_skein512_4way_avx2(const uint8_t* data, size_t size, uint8_t* output);
+void sph_cubehash512_4way_avx2(const uint8_t* data, size_t size, uint8_t* output);
+void sph_cubehash512_8way_avx2(const uint8_t* data, size_t size, uint8_t* output);
+void sph_shabal512_4way_avx2(const uint8_t* data, size_t size, uint8_t* output);
+void sph_shabal512_8way_avx2(const uint8_t* data, size_t size, uint8_t* output);
+#endif
+
+#if defined(XMRIG_FEATURE_AVX512F)
+void sph_blake512_8way_avx512(const uint8_t* data, size_t size, uint8_t* output);
+void sph_bmw512_8way_avx512(const uint8_t* data, size_t size, uint8_t* output);
+void sph_keccak512_8way_avx512(const uint8_t* data, size_t size, uint8_t* output);
+void sph_skein512_8way_avx512(const uint8_t* data, size_t size, uint8_t* output);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,291 @@
+/* XMRig
+ * Copyright 2018-2023 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2023 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * CubeHash-512 and Shabal-512 over 32-bit vector lanes, each lane of a register holds
+ * the same state word of a different message.
+ *
+ * This file can be included several times by the ISA specific sources, each time after defining:
+ *   MW                 vector type
+ *   MW_LANES           number of 32-bit lanes in MW
+ *   MW_NAME(x)         name decoration for the generated functions
+ *   MW_SET1, MW_LOADU, MW_STOREU, MW_ADD, MW_SUB, MW_XOR, MW_ANDNOT (~a & b),
+ *   MW_SHL, MW_ROL (shift/rotate counts are always literals)
+ */
+
+#include <string.h>
+
+#include "sph_types.h"
+
+
+#ifndef SPH_MULTI_32_TABLES
+#define SPH_MULTI_32_TABLES
+
+static const uint32_t cubehash512_iv[32] = {
+	SPH_C32(0x2AEA2A61), SPH_C32(0x50F494D4), SPH_C32(0x2D538B8B),
+	SPH_C32(0x4167D83E), SPH_C32(0x3FEE2313), SPH_C32(0xC701CF8C),
+	SPH_C32(0xCC39968E), SPH_C32(0x50AC5695), SPH_C32(0x4D42C787),
+	SPH_C32(0xA647A8B3), SPH_C32(0x97CF0BEF), SPH_C32(0x825B4537),
+	SPH_C32(0xEEF864D2), SPH_C32(0xF22090C4), SPH_C32(0xD0E5CD33),
+	SPH_C32(0xA23911AE), SPH_C32(0xFCD398D9), SPH_C32(0x148FE485),
+	SPH_C32(0x1B017BEF), SPH_C32(0xB6444532), SPH_C32(0x6A536159),
+	SPH_C32(0x2FF5781C), SPH_C32(0x91FA7934), SPH_C32(0x0DBADEA9),
+	SPH_C32(0xD65C8A2B), SPH_C32(0xA5A70E75), SPH_C32(0xB1C62456),
+	SPH_C32(0xBC796576), SPH_C32(0x1921C8F7), SPH_C32(0xE7989AF1),
+	SPH_C32(0x7795D246), SPH_C32(0xD43E3B44)
+};
+
+static const uint32_t shabal512_a[12] = {
+	SPH_C32(0x20728DFD), SPH_C32(0x46C0BD53), SPH_C32(0xE782B699), SPH_C32(0x55304632),
+	SPH_C32(0x71B4EF90), SPH_C32(0x0EA9E82C), SPH_C32(0xDBB930F1), SPH_C32(0xFAD06B8B),
+	SPH_C32(0xBE0CAE40), SPH_C32(0x8BD14410), SPH_C32(0x76D2ADAC), SPH_C32(0x28ACAB7F)
+};
+
+static const uint32_t shabal512_b[16] = {
+	SPH_C32(0xC1099CB7), SPH_C32(0x07B385F3), SPH_C32(0xE7442C26), SPH_C32(0xCC8AD640),
+	SPH_C32(0xEB6F56C7), SPH_C32(0x1EA81AA9), SPH_C32(0x73B9D314), SPH_C32(0x1DE85D08),
+	SPH_C32(0x48910A5A), SPH_C32(0x893B22DB), SPH_C32(0xC5A0DF44), SPH_C32(0xBBC4324E),
+	SPH_C32(0x72D2F240), SPH_C32(0x75941D99), SPH_C32(0x6D8BDE82), SPH_C32(0xA1A7502B)
+};
+
+static const uint32_t shabal512_c[16] = {
+	SPH_C32(0xD9BF68D1), SPH_C32(0x58BAD750), SPH_C32(0x56028CB2), SPH_C32(0x8134F359),
+	SPH_C32(0xB5D469D8), SPH_C32(0x941A8CC2), SPH_C32(0x418B2A6E), SPH_C32(0x04052780),
+	SPH_C32(0x7F07D787), SPH_C32(0x5194358F), SPH_C32(0x3C60D665), SPH_C32(0xBE97D79A),
+	SPH_C32(0x950C3434), SPH_C32(0xAED9A06D), SPH_C32(0x2537DC8D), SPH_C32(0x7CDB5969)
+};
+
+#endif /* SPH_MULTI_32_TABLES */
+
+
+static inline MW MW_NAME(load32le)(const uint8_t* const* p, size_t offset)
+{
+	uint32_t w[MW_LANES];
+	int k;
+
+	for (k = 0; k < MW_LANES; ++k) {
+		w[k] = sph_dec32le(p[k] + offset);
+	}
+
+	return MW_LOADU(w);
+}
+
+
+static inline void MW_NAME(store32le)(uint8_t* output, size_t offset, MW v)
+{
+	uint32_t w[MW_LANES];
+	int k;
+
+	MW_STOREU(w, v);
+
+	for (k = 0; k < MW_LANES; ++k) {
+		sph_enc32le(output + k * 64 + offset, w[k]);
+	}
+}
+
+
+/* Copies the unprocessed tail of every message into a zeroed block and appends the 0x80 padding byte */
+static inline void MW_NAME(make_tail32)(uint8_t (*tail)[64], const uint8_t** p, size_t rem)
+{
+	int k;
+
+	for (k = 0; k < MW_LANES; ++k) {
+		memcpy(tail[k], p[k], rem);
+		memset(tail[k] + rem, 0, 64 - rem);
+		tail[k][rem] = 0x80;
+		p[k] = tail[k];
+	}
+}
+
+
+static void MW_NAME(cubehash_rounds)(MW x[32], int rounds)
+{
+	MW y[16];
+	int r, i;
+
+	// The swaps of the specification are folded into the index arithmetic
+	for (r = 0; r < rounds; ++r) {
+		for (i = 0; i < 16; ++i) x[i + 16] = MW_ADD(x[i + 16], x[i]);
+		for (i = 0; i < 16; ++i) y[i ^ 8]  = MW_ROL(x[i], 7);
+		for (i = 0; i < 16; ++i) x[i]      = MW_XOR(y[i], x[i + 16]);
+		for (i = 0; i < 16; ++i) y[i ^ 2]  = x[i + 16];
+		for (i = 0; i < 16; ++i) x[i + 16] = MW_ADD(y[i], x[i]);
+		for (i = 0; i < 16; ++i) y[i ^ 4]  = MW_ROL(x[i], 11);
+		for (i = 0; i < 16; ++i) x[i]      = MW_XOR(y[i], x[i + 16]);
+		for (i = 0; i < 16; ++i) y[i ^ 1]  = x[i + 16];
+		for (i = 0; i < 16; ++i) x[i + 16] = y[i];
+	}
+}
+
+
+static inline void MW_NAME(cubehash_block)(MW x[32], const uint8_t* const* p)
+{
+	int i;
+
+	for (i = 0; i < 8; ++i) {
+		x[i] = MW_XOR(x[i], MW_NAME(load32le)(p, i * 4));
+	}
+
+	MW_NAME(cubehash_rounds)(x, 16);
+}
+
+
+void MW_NAME(sph_cubehash512)(const uint8_t* data, size_t size, uint8_t* output)
+{
+	const uint8_t* p[MW_LANES];
+	uint8_t tail[MW_LANES][64];
+	MW x[32];
+	size_t i;
+	int k;
+
+	for (i = 0; i < 32; ++i) {
+		x[i] = MW_SET1(cubehash512_iv[i]);
+	}
+
+	for (k = 0; k < MW_LANES; ++k) {
+		p[k] = data + k * size;
+	}
+
+	for (i = 0; i < size / 32; ++i) {
+		MW_NAME(cubehash_block)(x, p);
+
+		for (k = 0; k < MW_LANES; ++k) {
+			p[k] += 32;
+		}
+	}
+
+	MW_NAME(make_tail32)(tail, p, size % 32);
+	MW_NAME(cubehash_block)(x, p);
+
+	x[31] = MW_XOR(x[31], MW_SET1(1));
+	MW_NAME(cubehash_rounds)(x, 160);
+
+	for (i = 0; i < 16; ++i) {
+		MW_NAME(store32le)(output, i * 4, x[i]);
+	}
+}
+
+
+static void MW_NAME(shabal_perm)(MW a[12], MW b[16], const MW c[16], const MW m[16])
+{
+	const MW ones = MW_SET1(0xFFFFFFFFU);
+	int i, j;
+
+	for (i = 0; i < 16; ++i) {
+		b[i] = MW_ROL(b[i], 17);
+	}
+
+	for (j = 0; j < 48; ++j) {
+		const int ia = j % 12;
+		const int ib = j & 15;
+
+		// U(x) = 3 * x and V(x) = 5 * x of the specification
+		MW t = MW_ROL(a[(j + 11) % 12], 15);
+		t = MW_ADD(MW_SHL(t, 2), t);
+		t = MW_XOR(MW_XOR(a[ia], t), c[(8 - ib) & 15]);
+		t = MW_ADD(MW_SHL(t, 1), t);
+
+		a[ia] = MW_XOR(MW_XOR(t, b[(ib + 13) & 15]), MW_XOR(MW_ANDNOT(b[(ib + 6) & 15], b[(ib + 9) & 15]), m[ib]));
+		b[ib] = MW_XOR(MW_XOR(MW_ROL(b[ib], 1), a[ia]), ones);
+	}
+
+	for (j = 0; j < 36; ++j) {
+		a[j % 12] = MW_ADD(a[j % 12], c[(j + 3) & 15]);
+	}
+}
+
+
+static inline void MW_NAME(shabal_swap)(MW b[16], MW c[16])
+{
+	MW t[16];
+
+	memcpy(t, b, sizeof(t));
+	memcpy(b, c, sizeof(t));
+	memcpy(c, t, sizeof(t));
+}
+
+
+void MW_NAME(sph_shabal512)(const uint8_t* data, size_t size, uint8_t* output)
+{
+	const uint8_t* p[MW_LANES];
+	uint8_t tail[MW_LANES][64];
+	MW a[12];
+	MW b[16];
+	MW c[16];
+	MW m[16];
+	uint64_t w = 1;
+	size_t i, j;
+	int k;
+
+	for (i = 0; i < 12; ++i) {
+		a[i] = MW_SET1(shabal512_a[i]);
+	}
+
+	for (i = 0; i < 16; ++i) {
+		b[i] = MW_SET1(shabal512_b[i]);
+		c[i] = MW_SET1(shabal512_c[i]);
+	}
+
+	for (k = 0; k < MW_LANES; ++k) {
+		p[k] = data + k * size;
+	}
+
+	for (i = 0; i <= size / 64; ++i) {
+		const int last = (i == size / 64);
+
+		if (last) {
+			MW_NAME(make_tail32)(tail, p, size % 64);
+		}
+
+		for (j = 0; j < 16; ++j) {
+			m[j] = MW_NAME(load32le)(p, j * 4);
+			b[j] = MW_ADD(b[j], m[j]);
+		}
+
+		a[0] = MW_XOR(a[0], MW_SET1((uint32_t) w));
+		a[1] = MW_XOR(a[1], MW_SET1((uint32_t)(w >> 32)));
+		MW_NAME(shabal_perm)(a, b, c, m);
+
+		if (last) {
+			break;
+		}
+
+		for (j = 0; j < 16; ++j) {
+			c[j] = MW_SUB(c[j], m[j]);
+		}
+
+		MW_NAME(shabal_swap)(b, c);
+		++w;
+
+		for (k = 0; k < MW_LANES; ++k) {
+			p[k] += 64;
+		}
+	}
+
+	// Three final rounds with the last message block and counter
+	for (i = 0; i < 3; ++i) {
+		MW_NAME(shabal_swap)(b, c);
+		a[0] = MW_XOR(a[0], MW_SET1((uint32_t) w));
+		a[1] = MW_XOR(a[1], MW_SET1((uint32_t)(w >> 32)));
+		MW_NAME(shabal_perm)(a, b, c, m);
+	}
+
+	for (i = 0; i < 16; ++i) {
+		MW_NAME(store32le)(output, i * 4, b[i]);
+	}
+}
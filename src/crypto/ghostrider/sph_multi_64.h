@@ -0,0 +1,722 @@
+/* XMRig
+ * Copyright 2018-2023 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2023 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Blake-512, BMW-512, Keccak-512 and Skein-512 over 64-bit vector lanes, each lane of a
+ * register holds the same state word of a different message.
+ *
+ * This file is included by the ISA specific sources after defining:
+ *   MV                 vector type
+ *   MV_LANES           number of 64-bit lanes in MV
+ *   MV_NAME(x)         name decoration for the generated functions
+ *   MV_SET1, MV_LOADU, MV_STOREU, MV_ADD, MV_SUB, MV_XOR, MV_AND, MV_OR, MV_ANDNOT (~a & b),
+ *   MV_SHL, MV_SHR, MV_ROL (shift/rotate counts are always literals)
+ */
+
+#include <string.h>
+
+#include "sph_types.h"
+
+
+#ifndef SPH_MULTI_64_TABLES
+#define SPH_MULTI_64_TABLES
+
+static const uint64_t blake512_iv[8] = {
+	SPH_C64(0x6A09E667F3BCC908), SPH_C64(0xBB67AE8584CAA73B),
+	SPH_C64(0x3C6EF372FE94F82B), SPH_C64(0xA54FF53A5F1D36F1),
+	SPH_C64(0x510E527FADE682D1), SPH_C64(0x9B05688C2B3E6C1F),
+	SPH_C64(0x1F83D9ABFB41BD6B), SPH_C64(0x5BE0CD19137E2179)
+};
+
+static const uint64_t blake512_cb[16] = {
+	SPH_C64(0x243F6A8885A308D3), SPH_C64(0x13198A2E03707344),
+	SPH_C64(0xA4093822299F31D0), SPH_C64(0x082EFA98EC4E6C89),
+	SPH_C64(0x452821E638D01377), SPH_C64(0xBE5466CF34E90C6C),
+	SPH_C64(0xC0AC29B7C97C50DD), SPH_C64(0x3F84D5B5B5470917),
+	SPH_C64(0x9216D5D98979FB1B), SPH_C64(0xD1310BA698DFB5AC),
+	SPH_C64(0x2FFD72DBD01ADFB7), SPH_C64(0xB8E1AFED6A267E96),
+	SPH_C64(0xBA7C9045F12C7F99), SPH_C64(0x24A19947B3916CF7),
+	SPH_C64(0x0801F2E2858EFC16), SPH_C64(0x636920D871574E69)
+};
+
+static const uint8_t blake512_sigma[10][16] = {
+	{  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15 },
+	{ 14, 10,  4,  8,  9, 15, 13,  6,  1, 12,  0,  2, 11,  7,  5,  3 },
+	{ 11,  8, 12,  0,  5,  2, 15, 13, 10, 14,  3,  6,  7,  1,  9,  4 },
+	{  7,  9,  3,  1, 13, 12, 11, 14,  2,  6,  5, 10,  4,  0, 15,  8 },
+	{  9,  0,  5,  7,  2,  4, 10, 15, 14,  1, 11, 12,  6,  8,  3, 13 },
+	{  2, 12,  6, 10,  0, 11,  8,  3,  4, 13,  7,  5, 15, 14,  1,  9 },
+	{ 12,  5,  1, 15, 14, 13,  4, 10,  0,  7,  6,  3,  9,  2,  8, 11 },
+	{ 13, 11,  7, 14, 12,  1,  3,  9,  5,  0, 15,  4,  8,  6,  2, 10 },
+	{  6, 15, 14,  9, 11,  3,  0,  8, 12,  2, 13,  7,  1,  4, 10,  5 },
+	{ 10,  2,  8,  4,  7,  6,  1,  5, 15, 11,  9, 14,  3, 12, 13,  0 }
+};
+
+static const uint64_t bmw512_iv[16] = {
+	SPH_C64(0x8081828384858687), SPH_C64(0x88898A8B8C8D8E8F),
+	SPH_C64(0x9091929394959697), SPH_C64(0x98999A9B9C9D9E9F),
+	SPH_C64(0xA0A1A2A3A4A5A6A7), SPH_C64(0xA8A9AAABACADAEAF),
+	SPH_C64(0xB0B1B2B3B4B5B6B7), SPH_C64(0xB8B9BABBBCBDBEBF),
+	SPH_C64(0xC0C1C2C3C4C5C6C7), SPH_C64(0xC8C9CACBCCCDCECF),
+	SPH_C64(0xD0D1D2D3D4D5D6D7), SPH_C64(0xD8D9DADBDCDDDEDF),
+	SPH_C64(0xE0E1E2E3E4E5E6E7), SPH_C64(0xE8E9EAEBECEDEEEF),
+	SPH_C64(0xF0F1F2F3F4F5F6F7), SPH_C64(0xF8F9FAFBFCFDFEFF)
+};
+
+static const uint64_t bmw512_final[16] = {
+	SPH_C64(0xaaaaaaaaaaaaaaa0), SPH_C64(0xaaaaaaaaaaaaaaa1),
+	SPH_C64(0xaaaaaaaaaaaaaaa2), SPH_C64(0xaaaaaaaaaaaaaaa3),
+	SPH_C64(0xaaaaaaaaaaaaaaa4), SPH_C64(0xaaaaaaaaaaaaaaa5),
+	SPH_C64(0xaaaaaaaaaaaaaaa6), SPH_C64(0xaaaaaaaaaaaaaaa7),
+	SPH_C64(0xaaaaaaaaaaaaaaa8), SPH_C64(0xaaaaaaaaaaaaaaa9),
+	SPH_C64(0xaaaaaaaaaaaaaaaa), SPH_C64(0xaaaaaaaaaaaaaaab),
+	SPH_C64(0xaaaaaaaaaaaaaaac), SPH_C64(0xaaaaaaaaaaaaaaad),
+	SPH_C64(0xaaaaaaaaaaaaaaae), SPH_C64(0xaaaaaaaaaaaaaaaf)
+};
+
+static const uint64_t keccak_rc[24] = {
+	SPH_C64(0x0000000000000001), SPH_C64(0x0000000000008082),
+	SPH_C64(0x800000000000808A), SPH_C64(0x8000000080008000),
+	SPH_C64(0x000000000000808B), SPH_C64(0x0000000080000001),
+	SPH_C64(0x8000000080008081), SPH_C64(0x8000000000008009),
+	SPH_C64(0x000000000000008A), SPH_C64(0x0000000000000088),
+	SPH_C64(0x0000000080008009), SPH_C64(0x000000008000000A),
+	SPH_C64(0x000000008000808B), SPH_C64(0x800000000000008B),
+	SPH_C64(0x8000000000008089), SPH_C64(0x8000000000008003),
+	SPH_C64(0x8000000000008002), SPH_C64(0x8000000000000080),
+	SPH_C64(0x000000000000800A), SPH_C64(0x800000008000000A),
+	SPH_C64(0x8000000080008081), SPH_C64(0x8000000000008080),
+	SPH_C64(0x0000000080000001), SPH_C64(0x8000000080008008)
+};
+
+static const uint64_t skein512_iv[8] = {
+	SPH_C64(0x4903ADFF749C51CE), SPH_C64(0x0D95DE399746DF03),
+	SPH_C64(0x8FD1934127C79BCE), SPH_C64(0x9A255629FF352CB1),
+	SPH_C64(0x5DB62599DF6CA7B0), SPH_C64(0xEABE394CA9D5C3F4),
+	SPH_C64(0x991112C71A75B523), SPH_C64(0xAE18A40B660FCC33)
+};
+
+
+#define BLAKE512_G(i, a, b, c, d)   do { \
+		a = MV_ADD(MV_ADD(a, b), MV_XOR(m[s[2 * (i)]], MV_SET1(blake512_cb[s[2 * (i) + 1]]))); \
+		d = MV_ROL(MV_XOR(d, a), 32); \
+		c = MV_ADD(c, d); \
+		b = MV_ROL(MV_XOR(b, c), 39); \
+		a = MV_ADD(MV_ADD(a, b), MV_XOR(m[s[2 * (i) + 1]], MV_SET1(blake512_cb[s[2 * (i)]]))); \
+		d = MV_ROL(MV_XOR(d, a), 48); \
+		c = MV_ADD(c, d); \
+		b = MV_ROL(MV_XOR(b, c), 53); \
+	} while (0)
+
+#define KECCAK_RHO_PI(j, r)   do { \
+		MV u = a[j]; \
+		a[j] = MV_ROL(t, r); \
+		t = u; \
+	} while (0)
+
+#define BMW_ADD5(a, op1, b, op2, c, op3, d, op4, e) \
+	op4(op3(op2(op1(mh[a], mh[b]), mh[c]), mh[d]), mh[e])
+
+#define BMW_FOLD0(i, xh_, q_) \
+	MV_ADD(MV_XOR(MV_XOR(xh_, q_), m[i]), MV_XOR(MV_XOR(xl, q[24 + (i)]), q[i]))
+
+#define BMW_FOLD1(i, r, xl_, qa) \
+	MV_ADD(MV_ADD(MV_ROL(dh[((i) - 4) & 7], r), MV_XOR(MV_XOR(xh, q[16 + (i)]), m[i])), MV_XOR(MV_XOR(xl_, q[qa]), q[i]))
+
+#define SKEIN_ADDKEY(s)   do { \
+		p[0] = MV_ADD(p[0], k[((s) + 0) % 9]); \
+		p[1] = MV_ADD(p[1], k[((s) + 1) % 9]); \
+		p[2] = MV_ADD(p[2], k[((s) + 2) % 9]); \
+		p[3] = MV_ADD(p[3], k[((s) + 3) % 9]); \
+		p[4] = MV_ADD(p[4], k[((s) + 4) % 9]); \
+		p[5] = MV_ADD(p[5], MV_ADD(k[((s) + 5) % 9], MV_SET1(t[(s) % 3]))); \
+		p[6] = MV_ADD(p[6], MV_ADD(k[((s) + 6) % 9], MV_SET1(t[((s) + 1) % 3]))); \
+		p[7] = MV_ADD(p[7], MV_ADD(k[((s) + 7) % 9], MV_SET1((uint64_t)(s)))); \
+	} while (0)
+
+#define SKEIN_MIX(a, b, r)   do { \
+		p[a] = MV_ADD(p[a], p[b]); \
+		p[b] = MV_XOR(MV_ROL(p[b], r), p[a]); \
+	} while (0)
+
+#define SKEIN_ROUNDS(s, r0, r1, r2, r3, r4, r5, r6, r7, r8, r9, r10, r11, r12, r13, r14, r15)   do { \
+		SKEIN_ADDKEY(s); \
+		SKEIN_MIX(0, 1, r0);  SKEIN_MIX(2, 3, r1);  SKEIN_MIX(4, 5, r2);  SKEIN_MIX(6, 7, r3); \
+		SKEIN_MIX(2, 1, r4);  SKEIN_MIX(4, 7, r5);  SKEIN_MIX(6, 5, r6);  SKEIN_MIX(0, 3, r7); \
+		SKEIN_MIX(4, 1, r8);  SKEIN_MIX(6, 3, r9);  SKEIN_MIX(0, 5, r10); SKEIN_MIX(2, 7, r11); \
+		SKEIN_MIX(6, 1, r12); SKEIN_MIX(0, 7, r13); SKEIN_MIX(2, 5, r14); SKEIN_MIX(4, 3, r15); \
+	} while (0)
+
+#endif /* SPH_MULTI_64_TABLES */
+
+
+static inline MV MV_NAME(load64le)(const uint8_t* const* p, size_t offset)
+{
+	uint64_t w[MV_LANES];
+	int k;
+
+	for (k = 0; k < MV_LANES; ++k) {
+		w[k] = sph_dec64le(p[k] + offset);
+	}
+
+	return MV_LOADU(w);
+}
+
+
+static inline MV MV_NAME(load64be)(const uint8_t* const* p, size_t offset)
+{
+	uint64_t w[MV_LANES];
+	int k;
+
+	for (k = 0; k < MV_LANES; ++k) {
+		w[k] = sph_dec64be(p[k] + offset);
+	}
+
+	return MV_LOADU(w);
+}
+
+
+static inline void MV_NAME(store64le)(uint8_t* output, size_t offset, MV v)
+{
+	uint64_t w[MV_LANES];
+	int k;
+
+	MV_STOREU(w, v);
+
+	for (k = 0; k < MV_LANES; ++k) {
+		sph_enc64le(output + k * 64 + offset, w[k]);
+	}
+}
+
+
+static inline void MV_NAME(store64be)(uint8_t* output, size_t offset, MV v)
+{
+	uint64_t w[MV_LANES];
+	int k;
+
+	MV_STOREU(w, v);
+
+	for (k = 0; k < MV_LANES; ++k) {
+		sph_enc64be(output + k * 64 + offset, w[k]);
+	}
+}
+
+
+/*
+ * Copies the unprocessed tail of every message into a zeroed buffer of `blocks` blocks
+ * and appends the first padding byte, the algorithm specific part is added by the caller.
+ */
+static inline void MV_NAME(make_tail64)(uint8_t (*tail)[256], const uint8_t** p, size_t rem, uint8_t pad)
+{
+	int k;
+
+	for (k = 0; k < MV_LANES; ++k) {
+		memcpy(tail[k], p[k], rem);
+		memset(tail[k] + rem, 0, 256 - rem);
+		tail[k][rem] = pad;
+		p[k] = tail[k];
+	}
+}
+
+
+static void MV_NAME(blake512_compress)(MV h[8], const uint8_t* const* p, uint64_t t0, uint64_t t1)
+{
+	MV m[16];
+	MV v[16];
+	int i, r;
+
+	for (i = 0; i < 16; ++i) {
+		m[i] = MV_NAME(load64be)(p, i * 8);
+	}
+
+	for (i = 0; i < 8; ++i) {
+		v[i] = h[i];
+	}
+
+	v[8]  = MV_SET1(blake512_cb[0]);
+	v[9]  = MV_SET1(blake512_cb[1]);
+	v[10] = MV_SET1(blake512_cb[2]);
+	v[11] = MV_SET1(blake512_cb[3]);
+	v[12] = MV_SET1(t0 ^ blake512_cb[4]);
+	v[13] = MV_SET1(t0 ^ blake512_cb[5]);
+	v[14] = MV_SET1(t1 ^ blake512_cb[6]);
+	v[15] = MV_SET1(t1 ^ blake512_cb[7]);
+
+	for (r = 0; r < 16; ++r) {
+		const uint8_t* s = blake512_sigma[r % 10];
+
+		BLAKE512_G(0, v[0], v[4], v[8],  v[12]);
+		BLAKE512_G(1, v[1], v[5], v[9],  v[13]);
+		BLAKE512_G(2, v[2], v[6], v[10], v[14]);
+		BLAKE512_G(3, v[3], v[7], v[11], v[15]);
+		BLAKE512_G(4, v[0], v[5], v[10], v[15]);
+		BLAKE512_G(5, v[1], v[6], v[11], v[12]);
+		BLAKE512_G(6, v[2], v[7], v[8],  v[13]);
+		BLAKE512_G(7, v[3], v[4], v[9],  v[14]);
+	}
+
+	for (i = 0; i < 8; ++i) {
+		h[i] = MV_XOR(h[i], MV_XOR(v[i], v[i + 8]));
+	}
+}
+
+
+void MV_NAME(sph_blake512)(const uint8_t* data, size_t size, uint8_t* output)
+{
+	const uint8_t* p[MV_LANES];
+	uint8_t tail[MV_LANES][256];
+	MV h[8];
+	uint64_t t0 = 0;
+	uint64_t t1 = 0;
+	size_t i;
+	int k;
+
+	const uint64_t bits_lo = (uint64_t) size << 3;
+	const uint64_t bits_hi = (uint64_t) size >> 61;
+	const size_t rem       = size % 128;
+	const size_t blocks    = (rem < 112) ? 1 : 2;
+
+	for (i = 0; i < 8; ++i) {
+		h[i] = MV_SET1(blake512_iv[i]);
+	}
+
+	for (k = 0; k < MV_LANES; ++k) {
+		p[k] = data + k * size;
+	}
+
+	for (i = 0; i < size / 128; ++i) {
+		t0 += 1024;
+		if (t0 < 1024) {
+			++t1;
+		}
+
+		MV_NAME(blake512_compress)(h, p, t0, t1);
+
+		for (k = 0; k < MV_LANES; ++k) {
+			p[k] += 128;
+		}
+	}
+
+	MV_NAME(make_tail64)(tail, p, rem, 0x80);
+
+	for (k = 0; k < MV_LANES; ++k) {
+		tail[k][blocks * 128 - 17] |= 1;
+		sph_enc64be(tail[k] + blocks * 128 - 16, bits_hi);
+		sph_enc64be(tail[k] + blocks * 128 - 8, bits_lo);
+	}
+
+	// The counter of a block without message bits is zero
+	MV_NAME(blake512_compress)(h, p, rem ? bits_lo : 0, rem ? bits_hi : 0);
+
+	if (blocks == 2) {
+		for (k = 0; k < MV_LANES; ++k) {
+			p[k] += 128;
+		}
+
+		MV_NAME(blake512_compress)(h, p, 0, 0);
+	}
+
+	for (i = 0; i < 8; ++i) {
+		MV_NAME(store64be)(output, i * 8, h[i]);
+	}
+}
+
+
+static inline MV MV_NAME(bmw_s0)(MV x) { return MV_XOR(MV_XOR(MV_SHR(x, 1), MV_SHL(x, 3)), MV_XOR(MV_ROL(x,  4), MV_ROL(x, 37))); }
+static inline MV MV_NAME(bmw_s1)(MV x) { return MV_XOR(MV_XOR(MV_SHR(x, 1), MV_SHL(x, 2)), MV_XOR(MV_ROL(x, 13), MV_ROL(x, 43))); }
+static inline MV MV_NAME(bmw_s2)(MV x) { return MV_XOR(MV_XOR(MV_SHR(x, 2), MV_SHL(x, 1)), MV_XOR(MV_ROL(x, 19), MV_ROL(x, 53))); }
+static inline MV MV_NAME(bmw_s3)(MV x) { return MV_XOR(MV_XOR(MV_SHR(x, 2), MV_SHL(x, 2)), MV_XOR(MV_ROL(x, 28), MV_ROL(x, 59))); }
+static inline MV MV_NAME(bmw_s4)(MV x) { return MV_XOR(MV_SHR(x, 1), x); }
+static inline MV MV_NAME(bmw_s5)(MV x) { return MV_XOR(MV_SHR(x, 2), x); }
+
+
+static void MV_NAME(bmw512_compress)(const MV m[16], const MV h[16], MV dh[16])
+{
+	MV mh[16];
+	MV mr[16];
+	MV w[16];
+	MV q[32];
+	MV xl, xh;
+	int i, j;
+
+	for (i = 0; i < 16; ++i) {
+		mh[i] = MV_XOR(m[i], h[i]);
+	}
+
+	w[0]  = BMW_ADD5( 5, MV_SUB,  7, MV_ADD, 10, MV_ADD, 13, MV_ADD, 14);
+	w[1]  = BMW_ADD5( 6, MV_SUB,  8, MV_ADD, 11, MV_ADD, 14, MV_SUB, 15);
+	w[2]  = BMW_ADD5( 0, MV_ADD,  7, MV_ADD,  9, MV_SUB, 12, MV_ADD, 15);
+	w[3]  = BMW_ADD5( 0, MV_SUB,  1, MV_ADD,  8, MV_SUB, 10, MV_ADD, 13);
+	w[4]  = BMW_ADD5( 1, MV_ADD,  2, MV_ADD,  9, MV_SUB, 11, MV_SUB, 14);
+	w[5]  = BMW_ADD5( 3, MV_SUB,  2, MV_ADD, 10, MV_SUB, 12, MV_ADD, 15);
+	w[6]  = BMW_ADD5( 4, MV_SUB,  0, MV_SUB,  3, MV_SUB, 11, MV_ADD, 13);
+	w[7]  = BMW_ADD5( 1, MV_SUB,  4, MV_SUB,  5, MV_SUB, 12, MV_SUB, 14);
+	w[8]  = BMW_ADD5( 2, MV_SUB,  5, MV_SUB,  6, MV_ADD, 13, MV_SUB, 15);
+	w[9]  = BMW_ADD5( 0, MV_SUB,  3, MV_ADD,  6, MV_SUB,  7, MV_ADD, 14);
+	w[10] = BMW_ADD5( 8, MV_SUB,  1, MV_SUB,  4, MV_SUB,  7, MV_ADD, 15);
+	w[11] = BMW_ADD5( 8, MV_SUB,  0, MV_SUB,  2, MV_SUB,  5, MV_ADD,  9);
+	w[12] = BMW_ADD5( 1, MV_ADD,  3, MV_SUB,  6, MV_SUB,  9, MV_ADD, 10);
+	w[13] = BMW_ADD5( 2, MV_ADD,  4, MV_ADD,  7, MV_ADD, 10, MV_ADD, 11);
+	w[14] = BMW_ADD5( 3, MV_SUB,  5, MV_ADD,  8, MV_SUB, 11, MV_SUB, 12);
+	w[15] = BMW_ADD5(12, MV_SUB,  4, MV_SUB,  6, MV_SUB,  9, MV_ADD, 13);
+
+	q[0]  = MV_ADD(MV_NAME(bmw_s0)(w[0]),  h[1]);
+	q[1]  = MV_ADD(MV_NAME(bmw_s1)(w[1]),  h[2]);
+	q[2]  = MV_ADD(MV_NAME(bmw_s2)(w[2]),  h[3]);
+	q[3]  = MV_ADD(MV_NAME(bmw_s3)(w[3]),  h[4]);
+	q[4]  = MV_ADD(MV_NAME(bmw_s4)(w[4]),  h[5]);
+	q[5]  = MV_ADD(MV_NAME(bmw_s0)(w[5]),  h[6]);
+	q[6]  = MV_ADD(MV_NAME(bmw_s1)(w[6]),  h[7]);
+	q[7]  = MV_ADD(MV_NAME(bmw_s2)(w[7]),  h[8]);
+	q[8]  = MV_ADD(MV_NAME(bmw_s3)(w[8]),  h[9]);
+	q[9]  = MV_ADD(MV_NAME(bmw_s4)(w[9]),  h[10]);
+	q[10] = MV_ADD(MV_NAME(bmw_s0)(w[10]), h[11]);
+	q[11] = MV_ADD(MV_NAME(bmw_s1)(w[11]), h[12]);
+	q[12] = MV_ADD(MV_NAME(bmw_s2)(w[12]), h[13]);
+	q[13] = MV_ADD(MV_NAME(bmw_s3)(w[13]), h[14]);
+	q[14] = MV_ADD(MV_NAME(bmw_s4)(w[14]), h[15]);
+	q[15] = MV_ADD(MV_NAME(bmw_s0)(w[15]), h[0]);
+
+	mr[0]  = MV_ROL(m[0],   1);
+	mr[1]  = MV_ROL(m[1],   2);
+	mr[2]  = MV_ROL(m[2],   3);
+	mr[3]  = MV_ROL(m[3],   4);
+	mr[4]  = MV_ROL(m[4],   5);
+	mr[5]  = MV_ROL(m[5],   6);
+	mr[6]  = MV_ROL(m[6],   7);
+	mr[7]  = MV_ROL(m[7],   8);
+	mr[8]  = MV_ROL(m[8],   9);
+	mr[9]  = MV_ROL(m[9],  10);
+	mr[10] = MV_ROL(m[10], 11);
+	mr[11] = MV_ROL(m[11], 12);
+	mr[12] = MV_ROL(m[12], 13);
+	mr[13] = MV_ROL(m[13], 14);
+	mr[14] = MV_ROL(m[14], 15);
+	mr[15] = MV_ROL(m[15], 16);
+
+	for (i = 16; i < 32; ++i) {
+		const int e = i - 16;
+		const MV add_elt = MV_XOR(MV_ADD(MV_SUB(MV_ADD(mr[e], mr[(e + 3) & 15]), mr[(e + 10) & 15]),
+		                                 MV_SET1((uint64_t) i * SPH_C64(0x0555555555555555))), h[(e + 7) & 15]);
+		MV sum = add_elt;
+
+		if (i < 18) {
+			for (j = 0; j < 16; j += 4) {
+				sum = MV_ADD(sum, MV_NAME(bmw_s1)(q[e + j]));
+				sum = MV_ADD(sum, MV_NAME(bmw_s2)(q[e + j + 1]));
+				sum = MV_ADD(sum, MV_NAME(bmw_s3)(q[e + j + 2]));
+				sum = MV_ADD(sum, MV_NAME(bmw_s0)(q[e + j + 3]));
+			}
+		}
+		else {
+			sum = MV_ADD(sum, MV_ADD(q[e],      MV_ROL(q[e + 1],  5)));
+			sum = MV_ADD(sum, MV_ADD(q[e + 2],  MV_ROL(q[e + 3],  11)));
+			sum = MV_ADD(sum, MV_ADD(q[e + 4],  MV_ROL(q[e + 5],  27)));
+			sum = MV_ADD(sum, MV_ADD(q[e + 6],  MV_ROL(q[e + 7],  32)));
+			sum = MV_ADD(sum, MV_ADD(q[e + 8],  MV_ROL(q[e + 9],  37)));
+			sum = MV_ADD(sum, MV_ADD(q[e + 10], MV_ROL(q[e + 11], 43)));
+			sum = MV_ADD(sum, MV_ADD(q[e + 12], MV_ROL(q[e + 13], 53)));
+			sum = MV_ADD(sum, MV_ADD(MV_NAME(bmw_s4)(q[e + 14]), MV_NAME(bmw_s5)(q[e + 15])));
+		}
+
+		q[i] = sum;
+	}
+
+	xl = q[16];
+	for (i = 17; i < 24; ++i) {
+		xl = MV_XOR(xl, q[i]);
+	}
+
+	xh = xl;
+	for (i = 24; i < 32; ++i) {
+		xh = MV_XOR(xh, q[i]);
+	}
+
+	dh[0]  = BMW_FOLD0(0, MV_SHL(xh, 5),  MV_SHR(q[16], 5));
+	dh[1]  = BMW_FOLD0(1, MV_SHR(xh, 7),  MV_SHL(q[17], 8));
+	dh[2]  = BMW_FOLD0(2, MV_SHR(xh, 5),  MV_SHL(q[18], 5));
+	dh[3]  = BMW_FOLD0(3, MV_SHR(xh, 1),  MV_SHL(q[19], 5));
+	dh[4]  = BMW_FOLD0(4, MV_SHR(xh, 3),  q[20]);
+	dh[5]  = BMW_FOLD0(5, MV_SHL(xh, 6),  MV_SHR(q[21], 6));
+	dh[6]  = BMW_FOLD0(6, MV_SHR(xh, 4),  MV_SHL(q[22], 6));
+	dh[7]  = BMW_FOLD0(7, MV_SHR(xh, 11), MV_SHL(q[23], 2));
+
+	dh[8]  = BMW_FOLD1(8,  9,  MV_SHL(xl, 8), 23);
+	dh[9]  = BMW_FOLD1(9,  10, MV_SHR(xl, 6), 16);
+	dh[10] = BMW_FOLD1(10, 11, MV_SHL(xl, 6), 17);
+	dh[11] = BMW_FOLD1(11, 12, MV_SHL(xl, 4), 18);
+	dh[12] = BMW_FOLD1(12, 13, MV_SHR(xl, 3), 19);
+	dh[13] = BMW_FOLD1(13, 14, MV_SHR(xl, 4), 20);
+	dh[14] = BMW_FOLD1(14, 15, MV_SHR(xl, 7), 21);
+	dh[15] = BMW_FOLD1(15, 16, MV_SHR(xl, 2), 22);
+}
+
+
+static inline void MV_NAME(bmw512_block)(MV h[16], const uint8_t* const* p)
+{
+	MV m[16];
+	MV dh[16];
+	int i;
+
+	for (i = 0; i < 16; ++i) {
+		m[i] = MV_NAME(load64le)(p, i * 8);
+	}
+
+	MV_NAME(bmw512_compress)(m, h, dh);
+	memcpy(h, dh, sizeof(dh));
+}
+
+
+void MV_NAME(sph_bmw512)(const uint8_t* data, size_t size, uint8_t* output)
+{
+	const uint8_t* p[MV_LANES];
+	uint8_t tail[MV_LANES][256];
+	MV h[16];
+	MV f[16];
+	MV out[16];
+	size_t i;
+	int k;
+
+	const size_t rem    = size % 128;
+	const size_t blocks = (rem + 1 > 120) ? 2 : 1;
+
+	for (i = 0; i < 16; ++i) {
+		h[i] = MV_SET1(bmw512_iv[i]);
+		f[i] = MV_SET1(bmw512_final[i]);
+	}
+
+	for (k = 0; k < MV_LANES; ++k) {
+		p[k] = data + k * size;
+	}
+
+	for (i = 0; i < size / 128; ++i) {
+		MV_NAME(bmw512_block)(h, p);
+
+		for (k = 0; k < MV_LANES; ++k) {
+			p[k] += 128;
+		}
+	}
+
+	MV_NAME(make_tail64)(tail, p, rem, 0x80);
+
+	for (k = 0; k < MV_LANES; ++k) {
+		sph_enc64le(tail[k] + blocks * 128 - 8, (uint64_t) size << 3);
+	}
+
+	for (i = 0; i < blocks; ++i) {
+		MV_NAME(bmw512_block)(h, p);
+
+		for (k = 0; k < MV_LANES; ++k) {
+			p[k] += 128;
+		}
+	}
+
+	MV_NAME(bmw512_compress)(h, f, out);
+
+	for (i = 0; i < 8; ++i) {
+		MV_NAME(store64le)(output, i * 8, out[i + 8]);
+	}
+}
+
+
+static void MV_NAME(keccak_f1600)(MV a[25])
+{
+	int r, x, y;
+
+	for (r = 0; r < 24; ++r) {
+		MV c[5];
+		MV t;
+
+		for (x = 0; x < 5; ++x) {
+			c[x] = MV_XOR(MV_XOR(MV_XOR(a[x], a[x + 5]), MV_XOR(a[x + 10], a[x + 15])), a[x + 20]);
+		}
+
+		for (x = 0; x < 5; ++x) {
+			const MV d = MV_XOR(c[(x + 4) % 5], MV_ROL(c[(x + 1) % 5], 1));
+
+			for (y = 0; y < 25; y += 5) {
+				a[y + x] = MV_XOR(a[y + x], d);
+			}
+		}
+
+		t = a[1];
+		KECCAK_RHO_PI(10,  1);
+		KECCAK_RHO_PI( 7,  3);
+		KECCAK_RHO_PI(11,  6);
+		KECCAK_RHO_PI(17, 10);
+		KECCAK_RHO_PI(18, 15);
+		KECCAK_RHO_PI( 3, 21);
+		KECCAK_RHO_PI( 5, 28);
+		KECCAK_RHO_PI(16, 36);
+		KECCAK_RHO_PI( 8, 45);
+		KECCAK_RHO_PI(21, 55);
+		KECCAK_RHO_PI(24,  2);
+		KECCAK_RHO_PI( 4, 14);
+		KECCAK_RHO_PI(15, 27);
+		KECCAK_RHO_PI(23, 41);
+		KECCAK_RHO_PI(19, 56);
+		KECCAK_RHO_PI(13,  8);
+		KECCAK_RHO_PI(12, 25);
+		KECCAK_RHO_PI( 2, 43);
+		KECCAK_RHO_PI(20, 62);
+		KECCAK_RHO_PI(14, 18);
+		KECCAK_RHO_PI(22, 39);
+		KECCAK_RHO_PI( 9, 61);
+		KECCAK_RHO_PI( 6, 20);
+		KECCAK_RHO_PI( 1, 44);
+
+		for (y = 0; y < 25; y += 5) {
+			for (x = 0; x < 5; ++x) {
+				c[x] = a[y + x];
+			}
+
+			for (x = 0; x < 5; ++x) {
+				a[y + x] = MV_XOR(c[x], MV_ANDNOT(c[(x + 1) % 5], c[(x + 2) % 5]));
+			}
+		}
+
+		a[0] = MV_XOR(a[0], MV_SET1(keccak_rc[r]));
+	}
+}
+
+
+void MV_NAME(sph_keccak512)(const uint8_t* data, size_t size, uint8_t* output)
+{
+	enum { RATE = 72 };
+
+	const uint8_t* p[MV_LANES];
+	uint8_t tail[MV_LANES][256];
+	MV a[25];
+	size_t i, j;
+	int k;
+
+	const size_t rem = size % RATE;
+
+	for (i = 0; i < 25; ++i) {
+		a[i] = MV_SET1(0);
+	}
+
+	for (k = 0; k < MV_LANES; ++k) {
+		p[k] = data + k * size;
+	}
+
+	for (i = 0; i <= size / RATE; ++i) {
+		if (i == size / RATE) {
+			// Original Keccak padding (0x01 ... 0x80), as used by sph_keccak512
+			MV_NAME(make_tail64)(tail, p, rem, 0x01);
+
+			for (k = 0; k < MV_LANES; ++k) {
+				tail[k][RATE - 1] |= 0x80;
+			}
+		}
+
+		for (j = 0; j < RATE / 8; ++j) {
+			a[j] = MV_XOR(a[j], MV_NAME(load64le)(p, j * 8));
+		}
+
+		MV_NAME(keccak_f1600)(a);
+
+		for (k = 0; k < MV_LANES; ++k) {
+			p[k] += RATE;
+		}
+	}
+
+	for (i = 0; i < 8; ++i) {
+		MV_NAME(store64le)(output, i * 8, a[i]);
+	}
+}
+
+
+static void MV_NAME(skein512_ubi)(MV h[8], const MV m[8], uint64_t t0, uint64_t t1)
+{
+	const uint64_t t[3] = { t0, t1, t0 ^ t1 };
+	MV k[9];
+	MV p[8];
+	int i, s;
+
+	k[8] = MV_SET1(SPH_C64(0x1BD11BDAA9FC1A22));
+
+	for (i = 0; i < 8; ++i) {
+		k[i] = h[i];
+		k[8] = MV_XOR(k[8], h[i]);
+		p[i] = m[i];
+	}
+
+	for (s = 0; s < 18; s += 2) {
+		SKEIN_ROUNDS(s,     46, 36, 19, 37, 33, 27, 14, 42, 17, 49, 36, 39, 44,  9, 54, 56);
+		SKEIN_ROUNDS(s + 1, 39, 30, 34, 24, 13, 50, 10, 17, 25, 29, 39, 43,  8, 35, 56, 22);
+	}
+
+	SKEIN_ADDKEY(18);
+
+	for (i = 0; i < 8; ++i) {
+		h[i] = MV_XOR(m[i], p[i]);
+	}
+}
+
+
+void MV_NAME(sph_skein512)(const uint8_t* data, size_t size, uint8_t* output)
+{
+	const uint8_t* p[MV_LANES];
+	uint8_t tail[MV_LANES][256];
+	MV h[8];
+	MV m[8];
+	size_t b, i;
+	int k;
+
+	// Skein always processes at least one block, a full last block is not padded
+	const size_t blocks = size ? (size + 63) / 64 : 1;
+
+	for (i = 0; i < 8; ++i) {
+		h[i] = MV_SET1(skein512_iv[i]);
+	}
+
+	for (k = 0; k < MV_LANES; ++k) {
+		p[k] = data + k * size;
+	}
+
+	for (b = 0; b < blocks; ++b) {
+		const int last     = (b == blocks - 1);
+		const size_t bytes = last ? (size - b * 64) : 64;
+		const uint64_t et  = (last ? 352 : 96) + (b == 0 ? 128 : 0);
+
+		if (bytes < 64) {
+			MV_NAME(make_tail64)(tail, p, bytes, 0);
+		}
+
+		for (i = 0; i < 8; ++i) {
+			m[i] = MV_NAME(load64le)(p, i * 8);
+		}
+
+		MV_NAME(skein512_ubi)(h, m, b * 64 + bytes, et << 55);
+
+		for (k = 0; k < MV_LANES; ++k) {
+			p[k] += 64;
+		}
+	}
+
+	for (i = 0; i < 8; ++i) {
+		m[i] = MV_SET1(0);
+	}
+
+	MV_NAME(skein512_ubi)(h, m, 8, (uint64_t) 510 << 55);
+
+	for (i = 0; i < 8; ++i) {
+		MV_NAME(store64le)(output, i * 8, h[i]);
+	}
+}
@@ -0,0 +1,98 @@
+/* XMRig
+ * Copyright 2018-2023 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2023 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * AVX2 multi-buffer core hashes: 4 messages in the 64-bit lanes of a YMM register
+ * (Blake, BMW, Keccak, Skein) and 8 or 4 messages in 32-bit lanes (CubeHash, Shabal).
+ */
+
+#if defined(_M_X64) || defined(__x86_64__)
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+#include <immintrin.h>
+
+#include "sph_multi.h"
+
+
+#define MV                  __m256i
+#define MV_LANES            4
+#define MV_NAME(x)          x##_4way_avx2
+#define MV_SET1(x)          _mm256_set1_epi64x((int64_t)(x))
+#define MV_LOADU(p)         _mm256_loadu_si256((const __m256i*)(p))
+#define MV_STOREU(p, v)     _mm256_storeu_si256((__m256i*)(p), (v))
+#define MV_ADD(a, b)        _mm256_add_epi64((a), (b))
+#define MV_SUB(a, b)        _mm256_sub_epi64((a), (b))
+#define MV_XOR(a, b)        _mm256_xor_si256((a), (b))
+#define MV_AND(a, b)        _mm256_and_si256((a), (b))
+#define MV_OR(a, b)         _mm256_or_si256((a), (b))
+#define MV_ANDNOT(a, b)     _mm256_andnot_si256((a), (b))
+#define MV_SHL(x, n)        _mm256_slli_epi64((x), (n))
+#define MV_SHR(x, n)        _mm256_srli_epi64((x), (n))
+#define MV_ROL(x, n)        _mm256_or_si256(_mm256_slli_epi64((x), (n)), _mm256_srli_epi64((x), 64 - (n)))
+
+#include "sph_multi_64.h"
+
+
+#define MW                  __m256i
+#define MW_LANES            8
+#define MW_NAME(x)          x##_8way_avx2
+#define MW_SET1(x)          _mm256_set1_epi32((int)(x))
+#define MW_LOADU(p)         _mm256_loadu_si256((const __m256i*)(p))
+#define MW_STOREU(p, v)     _mm256_storeu_si256((__m256i*)(p), (v))
+#define MW_ADD(a, b)        _mm256_add_epi32((a), (b))
+#define MW_SUB(a, b)        _mm256_sub_epi32((a), (b))
+#define MW_XOR(a, b)        _mm256_xor_si256((a), (b))
+#define MW_ANDNOT(a, b)     _mm256_andnot_si256((a), (b))
+#define MW_SHL(x, n)        _mm256_slli_epi32((x), (n))
+#define MW_ROL(x, n)        _mm256_or_si256(_mm256_slli_epi32((x), (n)), _mm256_srli_epi32((x), 32 - (n)))
+
+#include "sph_multi_32.h"
+
+#undef MW
+#undef MW_LANES
+#undef MW_NAME
+#undef MW_SET1
+#undef MW_LOADU
+#undef MW_STOREU
+#undef MW_ADD
+#undef MW_SUB
+#undef MW_XOR
+#undef MW_ANDNOT
+#undef MW_SHL
+#undef MW_ROL
+
+
+#define MW                  __m128i
+#define MW_LANES            4
+#define MW_NAME(x)          x##_4way_avx2
+#define MW_SET1(x)          _mm_set1_epi32((int)(x))
+#define MW_LOADU(p)         _mm_loadu_si128((const __m128i*)(p))
+#define MW_STOREU(p, v)     _mm_storeu_si128((__m128i*)(p), (v))
+#define MW_ADD(a, b)        _mm_add_epi32((a), (b))
+#define MW_SUB(a, b)        _mm_sub_epi32((a), (b))
+#define MW_XOR(a, b)        _mm_xor_si128((a), (b))
+#define MW_ANDNOT(a, b)     _mm_andnot_si128((a), (b))
+#define MW_SHL(x, n)        _mm_slli_epi32((x), (n))
+#define MW_ROL(x, n)        _mm_or_si128(_mm_slli_epi32((x), (n)), _mm_srli_epi32((x), 32 - (n)))
+
+#include "sph_multi_32.h"
+
+#endif
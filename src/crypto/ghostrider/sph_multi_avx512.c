@@ -0,0 +1,53 @@
+/* XMRig
+ * Copyright 2018-2023 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2023 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * AVX-512 multi-buffer core hashes: all 8 messages of hash_octa() in the 64-bit lanes
+ * of a ZMM register (Blake, BMW, Keccak, Skein).
+ */
+
+#if defined(_M_X64) || defined(__x86_64__)
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+#include <immintrin.h>
+
+#include "sph_multi.h"
+
+
+#define MV                  __m512i
+#define MV_LANES            8
+#define MV_NAME(x)          x##_8way_avx512
+#define MV_SET1(x)          _mm512_set1_epi64((int64_t)(x))
+#define MV_LOADU(p)         _mm512_loadu_si512((const void*)(p))
+#define MV_STOREU(p, v)     _mm512_storeu_si512((void*)(p), (v))
+#define MV_ADD(a, b)        _mm512_add_epi64((a), (b))
+#define MV_SUB(a, b)        _mm512_sub_epi64((a), (b))
+#define MV_XOR(a, b)        _mm512_xor_si512((a), (b))
+#define MV_AND(a, b)        _mm512_and_si512((a), (b))
+#define MV_OR(a, b)         _mm512_or_si512((a), (b))
+#define MV_ANDNOT(a, b)     _mm512_andnot_si512((a), (b))
+#define MV_SHL(x, n)        _mm512_slli_epi64((x), (n))
+#define MV_SHR(x, n)        _mm512_srli_epi64((x), (n))
+#define MV_ROL(x, n)        _mm512_rol_epi64((x), (n))
+
+#include "sph_multi_64.h"
+
+#endif
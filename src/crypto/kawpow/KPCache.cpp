@@ -19,6 +19,7 @@
 
 #include <cinttypes>
 #include <algorithm>
+#include <mutex>
 #include <thread>
 
 #include "crypto/kawpow/KPCache.h"
@@ -34,8 +35,67 @@
 namespace xmrig {
 
 
-std::mutex KPCache::s_cacheMutex;
-KPCache KPCache::s_cache;
+static std::mutex cacheMutex;
+static std::shared_ptr<const KPCache> current;
+static std::shared_ptr<KPCache> next;
+static std::atomic<bool> fullDAG{ false };
+
+
+// Runs one background job at a time, a new job aborts the previous one. Neither abort() nor start() wait for the
+// previous job, the new job's thread joins it before running, so callers can use them while holding cacheMutex.
+class KPCacheBackground
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE(KPCacheBackground)
+
+    KPCacheBackground() = default;
+
+    ~KPCacheBackground()
+    {
+        abort();
+
+        if (m_thread.joinable()) {
+            m_thread.join();
+        }
+    }
+
+    inline void abort() { m_abort->store(true); }
+
+    template<typename T>
+    void start(T &&job)
+    {
+        abort();
+
+        auto abort    = std::make_shared<std::atomic<bool> >(false);
+        auto previous = std::make_shared<std::thread>(std::move(m_thread));
+
+        m_abort  = abort;
+        m_thread = std::thread([job, abort, previous]() {
+            if (previous->joinable()) {
+                previous->join();
+            }
+
+            job(*abort);
+        });
+    }
+
+private:
+    std::shared_ptr<std::atomic<bool> > m_abort = std::make_shared<std::atomic<bool> >(false);
+    std::thread m_thread;
+};
+
+
+static KPCacheBackground background;
+
+
+static void initLight(ethash_light &cache, void *data, size_t size)
+{
+    cache.cache = data;
+    cache.cache_size = size;
+
+    cache.num_parent_nodes = cache.cache_size / sizeof(node);
+    KPCache::calculate_fast_mod_data(cache.num_parent_nodes, cache.reciprocal, cache.increment, cache.shift);
+}
 
 
 KPCache::KPCache()
@@ -71,11 +131,7 @@ bool KPCache::init(uint32_t epoch)
     ethash_compute_cache_nodes(m_memory->raw(), size, &seedhash);
 
     ethash_light cache;
-    cache.cache = m_memory->raw();
-    cache.cache_size = size;
-
-    cache.num_parent_nodes = cache.cache_size / sizeof(node);
-    calculate_fast_mod_data(cache.num_parent_nodes, cache.reciprocal, cache.increment, cache.shift);
+    initLight(cache, m_memory->raw(), size);
 
     const uint64_t cache_nodes = (size + sizeof(node) * 4 - 1) / sizeof(node);
     m_DAGCache.resize(cache_nodes * (sizeof(node) / sizeof(uint32_t)));
@@ -112,6 +168,73 @@ bool KPCache::init(uint32_t epoch)
 }
 
 
+bool KPCache::initDAG(const std::atomic<bool> &abort)
+{
+    if (dag()) {
+        return true;
+    }
+
+    if (m_epoch >= sizeof(dag_sizes) / sizeof(dag_sizes[0])) {
+        return false;
+    }
+
+    const uint64_t start_ms = Chrono::steadyMSecs();
+
+    const uint64_t size = dag_sizes[m_epoch];
+    std::shared_ptr<VirtualMemory> memory(new VirtualMemory(size, true, false, false));
+
+    if (!memory->raw()) {
+        LOG_ERR("%s " YELLOW("KawPow") RED(" failed to allocate %" PRIu64 " MB for the DAG"), Tags::miner(), size >> 20);
+
+        return false;
+    }
+
+    ethash_light cache;
+    initLight(cache, data(), m_size);
+
+    node *items = reinterpret_cast<node *>(memory->raw());
+    const uint64_t num_nodes = size / sizeof(node);
+    const uint64_t n = std::max(std::thread::hardware_concurrency(), 1U);
+
+    std::vector<std::thread> threads;
+    threads.reserve(n);
+
+    for (uint64_t i = 0; i < n; ++i) {
+        const uint32_t a = static_cast<uint32_t>((num_nodes / 4 * i / n) * 4);
+        const uint32_t b = (i + 1 == n) ? static_cast<uint32_t>(num_nodes) : static_cast<uint32_t>((num_nodes / 4 * (i + 1) / n) * 4);
+
+        threads.emplace_back([items, a, b, &cache, &abort]() {
+            uint32_t j = a;
+            while ((j + 4 <= b) && !abort) {
+                const uint32_t end = std::min(b & ~3U, j + 4096);
+                for (; j < end; j += 4) ethash_calculate_dag_item4_opt(items + j, j, num_dataset_parents, &cache);
+            }
+            for (; (j < b) && !abort; ++j) ethash_calculate_dag_item_opt(items + j, j, num_dataset_parents, &cache);
+        });
+    }
+
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    {
+        // Checked under the lock, so a DAG can't be published after setFullDAG(false) has released it
+        std::lock_guard<std::mutex> lock(cacheMutex);
+
+        if (abort) {
+            return false;
+        }
+
+        std::atomic_store(&m_dag, std::shared_ptr<const VirtualMemory>(memory));
+    }
+
+    LOG_INFO("%s " YELLOW("KawPow") " DAG for epoch " WHITE_BOLD("%u") " calculated " BLACK_BOLD("(%" PRIu64 " MB, huge pages %s, %" PRIu64 "ms)"),
+             Tags::miner(), m_epoch, size >> 20, memory->isHugePages() ? "on" : "off", Chrono::steadyMSecs() - start_ms);
+
+    return true;
+}
+
+
 void* KPCache::data() const
 {
     return m_memory ? m_memory->raw() : nullptr;
@@ -130,6 +253,76 @@ static inline uint32_t clz(uint32_t a)
 }
 
 
+std::shared_ptr<const KPCache> KPCache::get(uint32_t epoch)
+{
+    std::shared_ptr<const KPCache> cache = std::atomic_load(&current);
+    if (cache && cache->epoch() == epoch) {
+        return cache;
+    }
+
+    std::lock_guard<std::mutex> lock(cacheMutex);
+
+    cache = std::atomic_load(&current);
+    if (cache && cache->epoch() == epoch) {
+        return cache;
+    }
+
+    background.abort();
+
+    std::shared_ptr<KPCache> ready = std::atomic_load(&next);
+    if (!ready || ready->epoch() != epoch) {
+        ready = std::make_shared<KPCache>();
+
+        if (!ready->init(epoch)) {
+            return {};
+        }
+    }
+
+    std::atomic_store(&current, std::shared_ptr<const KPCache>(ready));
+    std::atomic_store(&next, std::shared_ptr<KPCache>());
+
+    background.start([ready, epoch](const std::atomic<bool> &abort) {
+        auto cache = std::make_shared<KPCache>();
+        if (cache->init(epoch + 1) && !abort) {
+            std::atomic_store(&next, cache);
+        }
+
+        if (fullDAG && !abort) {
+            ready->initDAG(abort);
+        }
+    });
+
+    return ready;
+}
+
+
+void KPCache::setFullDAG(bool enable)
+{
+    if (fullDAG.exchange(enable) == enable) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(cacheMutex);
+
+    auto cache = std::const_pointer_cast<KPCache>(std::atomic_load(&current));
+
+    if (!enable) {
+        background.abort();
+
+        // Freed by the last verification thread still using it
+        if (cache) {
+            cache->releaseDAG();
+        }
+
+        return;
+    }
+
+    if (cache && !cache->dag()) {
+        background.start([cache](const std::atomic<bool> &abort) { cache->initDAG(abort); });
+    }
+}
+
+
 uint64_t KPCache::cache_size(uint32_t epoch)
 {
     if (epoch >= sizeof(cache_sizes) / sizeof(cache_sizes[0])) {
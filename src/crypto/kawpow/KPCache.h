@@ -21,7 +21,10 @@
 
 
 #include "base/tools/Object.h"
-#include <mutex>
+
+
+#include <atomic>
+#include <memory>
 #include <vector>
 
 
@@ -45,6 +48,7 @@ public:
     ~KPCache();
 
     bool init(uint32_t epoch);
+    bool initDAG(const std::atomic<bool> &abort);
 
     void* data() const;
     size_t size() const { return m_size; }
@@ -52,19 +56,27 @@ public:
 
     const uint32_t* l1_cache() const { return m_DAGCache.data(); }
 
+    // Full DAG of the epoch, empty until initDAG() has finished or after releaseDAG(). Readers keep the returned pointer
+    // while they use the DAG, so it can be released at any time.
+    std::shared_ptr<const VirtualMemory> dag() const { return std::atomic_load(&m_dag); }
+    void releaseDAG() { std::atomic_store(&m_dag, std::shared_ptr<const VirtualMemory>()); }
+
     static uint64_t cache_size(uint32_t epoch);
     static uint64_t dag_size(uint32_t epoch);
 
     static void calculate_fast_mod_data(uint32_t divisor, uint32_t &reciprocal, uint32_t &increment, uint32_t& shift);
 
-    static std::mutex s_cacheMutex;
-    static KPCache s_cache;
+    // Cache of the given epoch, built on first use. Callers which ask for the current epoch don't take any lock.
+    // After an epoch switch the next epoch and the full DAG (if enabled) are calculated in the background.
+    static std::shared_ptr<const KPCache> get(uint32_t epoch);
+    static void setFullDAG(bool enable);
 
 private:
-    VirtualMemory* m_memory = nullptr;
+    std::shared_ptr<const VirtualMemory> m_dag;
     size_t m_size = 0;
-    uint32_t m_epoch = 0xFFFFFFFFUL;
     std::vector<uint32_t> m_DAGCache;
+    uint32_t m_epoch = 0xFFFFFFFFUL;
+    VirtualMemory* m_memory = nullptr;
 };
 
 
@@ -28,6 +28,7 @@
 #include "backend/cpu/Cpu.h"
 #include "crypto/kawpow/KPHash.h"
 #include "crypto/kawpow/KPCache.h"
+#include "crypto/common/VirtualMemory.h"
 #include "3rdparty/libethash/ethash.h"
 #include "3rdparty/libethash/ethash_internal.h"
 #include "3rdparty/libethash/data_sizes.h"
@@ -280,12 +281,19 @@ void KPHash::calculate(const KPCache& light_cache, uint32_t block_height, const
     uint32_t jcong0 = jcong;
 
     const bool has_popcnt = Cpu::info()->has(ICpuInfo::FLAG_POPCNT);
+    const auto dag_memory = light_cache.dag();
+    const node* dag = dag_memory ? reinterpret_cast<const node*>(dag_memory->raw()) : nullptr;
 
     for (uint32_t r = 0; r < ETHASH_ACCESSES; ++r) {
         uint32_t item_index = (mix[r % LANES][0] % num_items) * 4;
 
         node item[4];
-        ethash_calculate_dag_item4_opt(item, item_index, KPCache::num_dataset_parents, &cache);
+        if (dag) {
+            memcpy(item, dag + item_index, sizeof(item));
+        }
+        else {
+            ethash_calculate_dag_item4_opt(item, item_index, KPCache::num_dataset_parents, &cache);
+        }
 
         uint32_t dst_counter = 0;
         uint32_t src_counter = 0;
@@ -99,6 +99,13 @@ extern "C" {
     extern void (*rx_blake2b_compress)(blake2b_state * S, const uint8_t * block);
     extern int (*rx_blake2b)(void* out, size_t outlen, const void* in, size_t inlen);
 
+	/* Multi-buffer API: hashes count independent messages of the same length inlen */
+    void rx_blake2b_multi_default(void* const* out, size_t outlen, const void* const* in, size_t inlen, size_t count);
+    void rx_blake2b_multi_avx2(void* const* out, size_t outlen, const void* const* in, size_t inlen, size_t count);
+    void rx_blake2b_multi_avx512(void* const* out, size_t outlen, const void* const* in, size_t inlen, size_t count);
+
+    extern void (*rx_blake2b_multi)(void* const* out, size_t outlen, const void* const* in, size_t inlen, size_t count);
+
 	/* Argon2 Team - Begin Code */
 	int rxa2_blake2b_long(void *out, size_t outlen, const void *in, size_t inlen);
 	/* Argon2 Team - End Code */
@@ -0,0 +1,98 @@
+/*
+   BLAKE2 reference source code package - optimized C implementations
+
+   Copyright 2012, Samuel Neves <sneves@dei.uc.pt>.  You may use this under the
+   terms of the CC0, the OpenSSL Licence, or the Apache Public License 2.0, at
+   your option.  The terms of these licenses can be found at:
+
+   - CC0 1.0 Universal : http://creativecommons.org/publicdomain/zero/1.0
+   - OpenSSL license   : https://www.openssl.org/source/license.html
+   - Apache 2.0        : http://www.apache.org/licenses/LICENSE-2.0
+
+   More information about the BLAKE2 hash function can be found at
+   https://blake2.net.
+*/
+
+/* Shared helpers for the multi-buffer (one message per SIMD lane) Blake2b implementations */
+
+#ifndef BLAKE2B_MULTI_H
+#define BLAKE2B_MULTI_H
+
+#include <stdint.h>
+
+#include <immintrin.h>
+
+#include "crypto/randomx/blake2/endian.h"
+
+
+extern const uint64_t blake2b_IV[8];
+
+
+static const uint8_t blake2b_sigma_multi[12][16] = {
+	{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15},
+	{14, 10, 4, 8, 9, 15, 13, 6, 1, 12, 0, 2, 11, 7, 5, 3},
+	{11, 8, 12, 0, 5, 2, 15, 13, 10, 14, 3, 6, 7, 1, 9, 4},
+	{7, 9, 3, 1, 13, 12, 11, 14, 2, 6, 5, 10, 4, 0, 15, 8},
+	{9, 0, 5, 7, 2, 4, 10, 15, 14, 1, 11, 12, 6, 8, 3, 13},
+	{2, 12, 6, 10, 0, 11, 8, 3, 4, 13, 7, 5, 15, 14, 1, 9},
+	{12, 5, 1, 15, 14, 13, 4, 10, 0, 7, 6, 3, 9, 2, 8, 11},
+	{13, 11, 7, 14, 12, 1, 3, 9, 5, 0, 15, 4, 8, 6, 2, 10},
+	{6, 15, 14, 9, 11, 3, 0, 8, 12, 2, 13, 7, 1, 4, 10, 5},
+	{10, 2, 8, 4, 7, 6, 1, 5, 15, 11, 9, 14, 3, 12, 13, 0},
+	{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15},
+	{14, 10, 4, 8, 9, 15, 13, 6, 1, 12, 0, 2, 11, 7, 5, 3},
+};
+
+
+/* Loads one 128-byte block from each of 4 messages, m[i] holds word i of all 4 messages */
+static FORCE_INLINE void load_msg_4way(__m256i m[16], const uint8_t* p0, const uint8_t* p1, const uint8_t* p2, const uint8_t* p3)
+{
+	for (int i = 0; i < 4; ++i) {
+		const __m256i a = _mm256_loadu_si256((const __m256i*)(p0 + i * 32));
+		const __m256i b = _mm256_loadu_si256((const __m256i*)(p1 + i * 32));
+		const __m256i c = _mm256_loadu_si256((const __m256i*)(p2 + i * 32));
+		const __m256i d = _mm256_loadu_si256((const __m256i*)(p3 + i * 32));
+
+		const __m256i t0 = _mm256_unpacklo_epi64(a, b);
+		const __m256i t1 = _mm256_unpackhi_epi64(a, b);
+		const __m256i t2 = _mm256_unpacklo_epi64(c, d);
+		const __m256i t3 = _mm256_unpackhi_epi64(c, d);
+
+		m[i * 4 + 0] = _mm256_permute2x128_si256(t0, t2, 0x20);
+		m[i * 4 + 1] = _mm256_permute2x128_si256(t1, t3, 0x20);
+		m[i * 4 + 2] = _mm256_permute2x128_si256(t0, t2, 0x31);
+		m[i * 4 + 3] = _mm256_permute2x128_si256(t1, t3, 0x31);
+	}
+}
+
+
+/* Applies G to the 4 columns and then to the 4 diagonals of the state vector v[16] */
+#define BLAKE2B_MULTI_ROUND(G, r)             \
+	do {                                      \
+		G(r, 0, v[0], v[4], v[8],  v[12]);   \
+		G(r, 1, v[1], v[5], v[9],  v[13]);   \
+		G(r, 2, v[2], v[6], v[10], v[14]);   \
+		G(r, 3, v[3], v[7], v[11], v[15]);   \
+		G(r, 4, v[0], v[5], v[10], v[15]);   \
+		G(r, 5, v[1], v[6], v[11], v[12]);   \
+		G(r, 6, v[2], v[7], v[8],  v[13]);   \
+		G(r, 7, v[3], v[4], v[9],  v[14]);   \
+	} while ((void)0, 0)
+
+#define BLAKE2B_MULTI_ROUNDS(G)    \
+	do {                           \
+		BLAKE2B_MULTI_ROUND(G, 0);  \
+		BLAKE2B_MULTI_ROUND(G, 1);  \
+		BLAKE2B_MULTI_ROUND(G, 2);  \
+		BLAKE2B_MULTI_ROUND(G, 3);  \
+		BLAKE2B_MULTI_ROUND(G, 4);  \
+		BLAKE2B_MULTI_ROUND(G, 5);  \
+		BLAKE2B_MULTI_ROUND(G, 6);  \
+		BLAKE2B_MULTI_ROUND(G, 7);  \
+		BLAKE2B_MULTI_ROUND(G, 8);  \
+		BLAKE2B_MULTI_ROUND(G, 9);  \
+		BLAKE2B_MULTI_ROUND(G, 10); \
+		BLAKE2B_MULTI_ROUND(G, 11); \
+	} while ((void)0, 0)
+
+#endif
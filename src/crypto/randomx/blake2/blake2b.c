@@ -334,6 +334,12 @@ fail:
 	return ret;
 }
 
+void rx_blake2b_multi_default(void* const* out, size_t outlen, const void* const* in, size_t inlen, size_t count) {
+	for (size_t i = 0; i < count; ++i) {
+		rx_blake2b(out[i], outlen, in[i], inlen);
+	}
+}
+
 /* Argon2 Team - Begin Code */
 int rxa2_blake2b_long(void *pout, size_t outlen, const void *in, size_t inlen) {
 	uint8_t *out = (uint8_t *)pout;
@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2018-2019, tevador <tevador@gmail.com>
+ * Copyright 2018-2020 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2020 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+	* Redistributions of source code must retain the above copyright
+	  notice, this list of conditions and the following disclaimer.
+	* Redistributions in binary form must reproduce the above copyright
+	  notice, this list of conditions and the following disclaimer in the
+	  documentation and/or other materials provided with the distribution.
+	* Neither the name of the copyright holder nor the
+	  names of its contributors may be used to endorse or promote products
+	  derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+ * 4-way Blake2b: four independent messages of the same length are hashed at once,
+ * each 64-bit lane of a YMM register holds the same state word of a different message.
+ */
+
+#if defined(_M_X64) || defined(__x86_64__)
+
+#include <stdint.h>
+#include <string.h>
+
+#include "crypto/randomx/blake2/blake2.h"
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+#include <immintrin.h>
+
+#include "blake2b-multi.h"
+
+
+#define ROTR32(x) _mm256_shuffle_epi32((x), _MM_SHUFFLE(2, 3, 0, 1))
+#define ROTR24(x) _mm256_shuffle_epi8((x), _mm256_setr_epi8(3, 4, 5, 6, 7, 0, 1, 2, 11, 12, 13, 14, 15, 8, 9, 10, 3, 4, 5, 6, 7, 0, 1, 2, 11, 12, 13, 14, 15, 8, 9, 10))
+#define ROTR16(x) _mm256_shuffle_epi8((x), _mm256_setr_epi8(2, 3, 4, 5, 6, 7, 0, 1, 10, 11, 12, 13, 14, 15, 8, 9, 2, 3, 4, 5, 6, 7, 0, 1, 10, 11, 12, 13, 14, 15, 8, 9))
+#define ROTR63(x) _mm256_or_si256(_mm256_srli_epi64((x), 63), _mm256_add_epi64((x), (x)))
+
+#define G4(r, i, a, b, c, d)                                              \
+	do {                                                                  \
+		a = _mm256_add_epi64(_mm256_add_epi64(a, b), m[blake2b_sigma_multi[r][2 * i + 0]]); \
+		d = ROTR32(_mm256_xor_si256(d, a));                               \
+		c = _mm256_add_epi64(c, d);                                       \
+		b = ROTR24(_mm256_xor_si256(b, c));                               \
+		a = _mm256_add_epi64(_mm256_add_epi64(a, b), m[blake2b_sigma_multi[r][2 * i + 1]]); \
+		d = ROTR16(_mm256_xor_si256(d, a));                               \
+		c = _mm256_add_epi64(c, d);                                       \
+		b = ROTR63(_mm256_xor_si256(b, c));                               \
+	} while ((void)0, 0)
+
+
+static void blake2b_compress_4way(__m256i h[8], const __m256i m[16], uint64_t counter, uint64_t flag)
+{
+	__m256i v[16];
+
+	for (int i = 0; i < 8; ++i) {
+		v[i]     = h[i];
+		v[i + 8] = _mm256_set1_epi64x((int64_t) blake2b_IV[i]);
+	}
+
+	v[12] = _mm256_xor_si256(v[12], _mm256_set1_epi64x((int64_t) counter));
+	v[14] = _mm256_xor_si256(v[14], _mm256_set1_epi64x((int64_t) flag));
+
+	BLAKE2B_MULTI_ROUNDS(G4);
+
+	for (int i = 0; i < 8; ++i) {
+		h[i] = _mm256_xor_si256(h[i], _mm256_xor_si256(v[i], v[i + 8]));
+	}
+}
+
+
+static void blake2b_4way_avx2(void* const* out, size_t outlen, const void* const* in, size_t inlen)
+{
+	const uint8_t* p[4] = { (const uint8_t*) in[0], (const uint8_t*) in[1], (const uint8_t*) in[2], (const uint8_t*) in[3] };
+
+	__m256i h[8];
+	__m256i m[16];
+	uint64_t counter = 0;
+
+	for (int i = 0; i < 8; ++i) {
+		h[i] = _mm256_set1_epi64x((int64_t) blake2b_IV[i]);
+	}
+
+	h[0] = _mm256_xor_si256(h[0], _mm256_set1_epi64x(0x01010000 | (int64_t) outlen));
+
+	do {
+		const uint64_t flag = (inlen <= BLAKE2B_BLOCKBYTES) ? (uint64_t)-1 : 0;
+		size_t block_size   = BLAKE2B_BLOCKBYTES;
+
+		if (inlen < BLAKE2B_BLOCKBYTES) {
+			uint8_t buf[4][BLAKE2B_BLOCKBYTES];
+
+			for (int k = 0; k < 4; ++k) {
+				memcpy(buf[k], p[k], inlen);
+				memset(buf[k] + inlen, 0, BLAKE2B_BLOCKBYTES - inlen);
+			}
+
+			load_msg_4way(m, buf[0], buf[1], buf[2], buf[3]);
+			block_size = inlen;
+		}
+		else {
+			load_msg_4way(m, p[0], p[1], p[2], p[3]);
+		}
+
+		counter += block_size;
+		blake2b_compress_4way(h, m, counter, flag);
+
+		inlen -= block_size;
+		for (int k = 0; k < 4; ++k) {
+			p[k] += block_size;
+		}
+	} while (inlen > 0);
+
+	uint64_t result[8][4];
+	for (int i = 0; i < 8; ++i) {
+		_mm256_storeu_si256((__m256i*) result[i], h[i]);
+	}
+
+	for (int k = 0; k < 4; ++k) {
+		uint64_t words[8];
+		for (int i = 0; i < 8; ++i) {
+			words[i] = result[i][k];
+		}
+
+		memcpy(out[k], words, outlen);
+	}
+
+	_mm256_zeroupper();
+}
+
+
+void rx_blake2b_multi_avx2(void* const* out, size_t outlen, const void* const* in, size_t inlen, size_t count)
+{
+	size_t i = 0;
+
+	if (outlen > 0 && outlen <= BLAKE2B_OUTBYTES) {
+		for (; i + 4 <= count; i += 4) {
+			blake2b_4way_avx2(out + i, outlen, in + i, inlen);
+		}
+	}
+
+	for (; i < count; ++i) {
+		rx_blake2b(out[i], outlen, in[i], inlen);
+	}
+}
+
+#endif
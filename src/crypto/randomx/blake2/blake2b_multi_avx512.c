@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2018-2019, tevador <tevador@gmail.com>
+ * Copyright 2018-2020 SChernykh   <https://github.com/SChernykh>
+ * Copyright 2016-2020 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+	* Redistributions of source code must retain the above copyright
+	  notice, this list of conditions and the following disclaimer.
+	* Redistributions in binary form must reproduce the above copyright
+	  notice, this list of conditions and the following disclaimer in the
+	  documentation and/or other materials provided with the distribution.
+	* Neither the name of the copyright holder nor the
+	  names of its contributors may be used to endorse or promote products
+	  derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+ * 8-way Blake2b: eight independent messages of the same length are hashed at once,
+ * each 64-bit lane of a ZMM register holds the same state word of a different message.
+ */
+
+#if defined(_M_X64) || defined(__x86_64__)
+
+#include <stdint.h>
+#include <string.h>
+
+#include "crypto/randomx/blake2/blake2.h"
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+#include <immintrin.h>
+
+#include "blake2b-multi.h"
+
+
+#define G8(r, i, a, b, c, d)                                              \
+	do {                                                                  \
+		a = _mm512_add_epi64(_mm512_add_epi64(a, b), m[blake2b_sigma_multi[r][2 * i + 0]]); \
+		d = _mm512_ror_epi64(_mm512_xor_si512(d, a), 32);                 \
+		c = _mm512_add_epi64(c, d);                                       \
+		b = _mm512_ror_epi64(_mm512_xor_si512(b, c), 24);                 \
+		a = _mm512_add_epi64(_mm512_add_epi64(a, b), m[blake2b_sigma_multi[r][2 * i + 1]]); \
+		d = _mm512_ror_epi64(_mm512_xor_si512(d, a), 16);                 \
+		c = _mm512_add_epi64(c, d);                                       \
+		b = _mm512_ror_epi64(_mm512_xor_si512(b, c), 63);                 \
+	} while ((void)0, 0)
+
+
+static FORCE_INLINE void load_msg_8way(__m512i m[16], const uint8_t* const p[8])
+{
+	__m256i lo[16];
+	__m256i hi[16];
+
+	load_msg_4way(lo, p[0], p[1], p[2], p[3]);
+	load_msg_4way(hi, p[4], p[5], p[6], p[7]);
+
+	for (int i = 0; i < 16; ++i) {
+		m[i] = _mm512_inserti64x4(_mm512_castsi256_si512(lo[i]), hi[i], 1);
+	}
+}
+
+
+static void blake2b_compress_8way(__m512i h[8], const __m512i m[16], uint64_t counter, uint64_t flag)
+{
+	__m512i v[16];
+
+	for (int i = 0; i < 8; ++i) {
+		v[i]     = h[i];
+		v[i + 8] = _mm512_set1_epi64((int64_t) blake2b_IV[i]);
+	}
+
+	v[12] = _mm512_xor_si512(v[12], _mm512_set1_epi64((int64_t) counter));
+	v[14] = _mm512_xor_si512(v[14], _mm512_set1_epi64((int64_t) flag));
+
+	BLAKE2B_MULTI_ROUNDS(G8);
+
+	for (int i = 0; i < 8; ++i) {
+		h[i] = _mm512_xor_si512(h[i], _mm512_xor_si512(v[i], v[i + 8]));
+	}
+}
+
+
+static void blake2b_8way_avx512(void* const* out, size_t outlen, const void* const* in, size_t inlen)
+{
+	const uint8_t* p[8];
+	for (int k = 0; k < 8; ++k) {
+		p[k] = (const uint8_t*) in[k];
+	}
+
+	__m512i h[8];
+	__m512i m[16];
+	uint64_t counter = 0;
+
+	for (int i = 0; i < 8; ++i) {
+		h[i] = _mm512_set1_epi64((int64_t) blake2b_IV[i]);
+	}
+
+	h[0] = _mm512_xor_si512(h[0], _mm512_set1_epi64(0x01010000 | (int64_t) outlen));
+
+	do {
+		const uint64_t flag = (inlen <= BLAKE2B_BLOCKBYTES) ? (uint64_t)-1 : 0;
+		size_t block_size   = BLAKE2B_BLOCKBYTES;
+
+		if (inlen < BLAKE2B_BLOCKBYTES) {
+			uint8_t buf[8][BLAKE2B_BLOCKBYTES];
+			const uint8_t* b[8];
+
+			for (int k = 0; k < 8; ++k) {
+				memcpy(buf[k], p[k], inlen);
+				memset(buf[k] + inlen, 0, BLAKE2B_BLOCKBYTES - inlen);
+				b[k] = buf[k];
+			}
+
+			load_msg_8way(m, b);
+			block_size = inlen;
+		}
+		else {
+			load_msg_8way(m, p);
+		}
+
+		counter += block_size;
+		blake2b_compress_8way(h, m, counter, flag);
+
+		inlen -= block_size;
+		for (int k = 0; k < 8; ++k) {
+			p[k] += block_size;
+		}
+	} while (inlen > 0);
+
+	uint64_t result[8][8];
+	for (int i = 0; i < 8; ++i) {
+		_mm512_storeu_si512((void*) result[i], h[i]);
+	}
+
+	for (int k = 0; k < 8; ++k) {
+		uint64_t words[8];
+		for (int i = 0; i < 8; ++i) {
+			words[i] = result[i][k];
+		}
+
+		memcpy(out[k], words, outlen);
+	}
+
+	_mm256_zeroupper();
+}
+
+
+void rx_blake2b_multi_avx512(void* const* out, size_t outlen, const void* const* in, size_t inlen, size_t count)
+{
+	size_t i = 0;
+
+	if (outlen > 0 && outlen <= BLAKE2B_OUTBYTES) {
+		for (; i + 8 <= count; i += 8) {
+			blake2b_8way_avx512(out + i, outlen, in + i, inlen);
+		}
+	}
+
+	if (i < count) {
+		rx_blake2b_multi_avx2(out + i, outlen, in + i, inlen, count - i);
+	}
+}
+
+#endif
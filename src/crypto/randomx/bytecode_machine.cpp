@@ -29,6 +29,13 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "crypto/randomx/bytecode_machine.hpp"
 #include "crypto/randomx/reciprocal.h"
 
+static bool threadedInterpreter = true;
+
+void randomx_set_threaded_interpreter(bool enable)
+{
+	threadedInterpreter = enable;
+}
+
 namespace randomx {
 
 	const int_reg_t BytecodeMachine::zero = 0;
@@ -78,6 +85,128 @@ namespace randomx {
 		}
 	}
 
+	bool BytecodeMachine::isThreaded() {
+#		ifdef RANDOMX_THREADED_DISPATCH
+		return threadedInterpreter;
+#		else
+		return false;
+#		endif
+	}
+
+	void BytecodeMachine::prepareThreaded(InstructionByteCode* bytecode) {
+		const uint32_t size = RandomX_CurrentConfig.ProgramSize;
+
+		for (uint32_t pc = 0; pc < size; ++pc) {
+			auto& ibc = bytecode[pc];
+			ThreadedType type;
+
+			switch (ibc.type) {
+			case InstructionType::IADD_M:   type = ThreadedType::IADD_MZ;   break;
+			case InstructionType::ISUB_M:   type = ThreadedType::ISUB_MZ;   break;
+			case InstructionType::IMUL_M:   type = ThreadedType::IMUL_MZ;   break;
+			case InstructionType::IMULH_M:  type = ThreadedType::IMULH_MZ;  break;
+			case InstructionType::ISMULH_M: type = ThreadedType::ISMULH_MZ; break;
+			case InstructionType::IXOR_M:   type = ThreadedType::IXOR_MZ;   break;
+			case InstructionType::ISUB_R:   type = ThreadedType::ISUB_RI;   break;
+			case InstructionType::IMUL_R:   type = ThreadedType::IMUL_RI;   break;
+			case InstructionType::IXOR_R:   type = ThreadedType::IXOR_RI;   break;
+
+			default:
+				continue;
+			}
+
+			if (type < ThreadedType::ISUB_RI) {
+				if (ibc.isrc == &zero) {
+					ibc.imm &= ibc.memMask;
+					ibc.type = static_cast<InstructionType>(type);
+				}
+			}
+			else if (ibc.isrc == &ibc.imm) {
+				ibc.type = static_cast<InstructionType>(type);
+			}
+		}
+
+		bytecode[size].type = static_cast<InstructionType>(ThreadedType::END);
+	}
+
+#ifdef RANDOMX_THREADED_DISPATCH
+#define THREADED_HANDLER(x) x: exe_ ## x(*ibc, pc, scratchpad, config); DISPATCH();
+
+	void BytecodeMachine::executeBytecodeThreaded(InstructionByteCode* bytecode, uint8_t* scratchpad, ProgramConfiguration& config) {
+		// Must follow the numbering of InstructionType and ThreadedType
+		static const void* const handlers[] = {
+			&&IADD_RS, &&IADD_M, &&ISUB_R, &&ISUB_M, &&IMUL_R, &&IMUL_M, &&IMULH_R, &&IMULH_M, &&ISMULH_R, &&ISMULH_M,
+			&&UNREACHABLE_TYPE, &&INEG_R, &&IXOR_R, &&IXOR_M, &&IROR_R, &&IROL_R, &&ISWAP_R, &&FSWAP_R, &&FADD_R, &&FADD_M,
+			&&FSUB_R, &&FSUB_M, &&FSCAL_R, &&FMUL_R, &&FDIV_M, &&FSQRT_R, &&CBRANCH, &&CFROUND, &&ISTORE, &&NOP,
+			&&IADD_MZ, &&ISUB_MZ, &&IMUL_MZ, &&IMULH_MZ, &&ISMULH_MZ, &&IXOR_MZ, &&ISUB_RI, &&IMUL_RI, &&IXOR_RI, &&END
+		};
+
+		static_assert(sizeof(handlers) / sizeof(handlers[0]) == static_cast<size_t>(ThreadedType::COUNT), "Threaded dispatch table size mismatch");
+
+		int pc = 0;
+		InstructionByteCode* ibc = bytecode;
+
+#		define DISPATCH() ibc = &bytecode[++pc]; goto *handlers[static_cast<uint16_t>(ibc->type)]
+
+		goto *handlers[static_cast<uint16_t>(ibc->type)];
+
+		THREADED_HANDLER(IADD_RS)
+		THREADED_HANDLER(IADD_M)
+		THREADED_HANDLER(ISUB_R)
+		THREADED_HANDLER(ISUB_M)
+		THREADED_HANDLER(IMUL_R)
+		THREADED_HANDLER(IMUL_M)
+		THREADED_HANDLER(IMULH_R)
+		THREADED_HANDLER(IMULH_M)
+		THREADED_HANDLER(ISMULH_R)
+		THREADED_HANDLER(ISMULH_M)
+		THREADED_HANDLER(INEG_R)
+		THREADED_HANDLER(IXOR_R)
+		THREADED_HANDLER(IXOR_M)
+		THREADED_HANDLER(IROR_R)
+		THREADED_HANDLER(IROL_R)
+		THREADED_HANDLER(ISWAP_R)
+		THREADED_HANDLER(FSWAP_R)
+		THREADED_HANDLER(FADD_R)
+		THREADED_HANDLER(FADD_M)
+		THREADED_HANDLER(FSUB_R)
+		THREADED_HANDLER(FSUB_M)
+		THREADED_HANDLER(FSCAL_R)
+		THREADED_HANDLER(FMUL_R)
+		THREADED_HANDLER(FDIV_M)
+		THREADED_HANDLER(FSQRT_R)
+		THREADED_HANDLER(CBRANCH)
+		THREADED_HANDLER(CFROUND)
+		THREADED_HANDLER(ISTORE)
+		THREADED_HANDLER(IADD_MZ)
+		THREADED_HANDLER(ISUB_MZ)
+		THREADED_HANDLER(IMUL_MZ)
+		THREADED_HANDLER(IMULH_MZ)
+		THREADED_HANDLER(ISMULH_MZ)
+		THREADED_HANDLER(IXOR_MZ)
+		THREADED_HANDLER(ISUB_RI)
+		THREADED_HANDLER(IMUL_RI)
+		THREADED_HANDLER(IXOR_RI)
+
+	NOP:
+		DISPATCH();
+
+	UNREACHABLE_TYPE:
+		UNREACHABLE;
+
+	END:
+		return;
+
+#		undef DISPATCH
+	}
+
+#undef THREADED_HANDLER
+#else
+	void BytecodeMachine::executeBytecodeThreaded(InstructionByteCode* bytecode, uint8_t* scratchpad, ProgramConfiguration& config) {
+		executeBytecode(bytecode, scratchpad, config);
+	}
+#endif
+
 	void BytecodeMachine::compileInstruction(RANDOMX_GEN_ARGS) {
 		uint32_t opcode = instr.opcode;
 
@@ -64,6 +64,25 @@ namespace randomx {
 		uint32_t memMask;
 	};
 
+	// Specialised bytecode types used only by the threaded interpreter, numbered after InstructionType::NOP
+	enum class ThreadedType : uint16_t {
+		IADD_MZ = static_cast<uint16_t>(InstructionType::NOP) + 1,
+		ISUB_MZ,
+		IMUL_MZ,
+		IMULH_MZ,
+		ISMULH_MZ,
+		IXOR_MZ,
+		ISUB_RI,
+		IMUL_RI,
+		IXOR_RI,
+		END,
+		COUNT
+	};
+
+#if defined(__GNUC__) || defined(__clang__)
+#	define RANDOMX_THREADED_DISPATCH
+#endif
+
 #define RANDOMX_EXE_ARGS InstructionByteCode& ibc, int& pc, uint8_t* scratchpad, ProgramConfiguration& config
 #define RANDOMX_GEN_ARGS Instruction& instr, int i, InstructionByteCode& ibc
 
@@ -96,6 +115,15 @@ namespace randomx {
 			}
 		}
 
+		static bool isThreaded();
+
+		// Rewrites compiled bytecode to the specialised types and appends the END entry,
+		// bytecode must have room for RandomX_CurrentConfig.ProgramSize + 1 entries
+		static void prepareThreaded(InstructionByteCode* bytecode);
+
+		// Executes bytecode prepared by prepareThreaded() with one indirect jump per instruction
+		static void executeBytecodeThreaded(InstructionByteCode* bytecode, uint8_t* scratchpad, ProgramConfiguration& config);
+
 		void compileInstruction(RANDOMX_GEN_ARGS)
 #ifdef RANDOMX_GEN_TABLE
 		{
@@ -231,6 +259,44 @@ namespace randomx {
 		static void exe_ISTORE(RANDOMX_EXE_ARGS) {
 			store64(scratchpad + ((*ibc.idst + ibc.imm) & ibc.memMask), *ibc.isrc);
 		}
+
+		// Memory operand with a constant address (src == dst), prepareThreaded() stores the address in imm
+		static void exe_IADD_MZ(RANDOMX_EXE_ARGS) {
+			*ibc.idst += load64(scratchpad + ibc.imm);
+		}
+
+		static void exe_ISUB_MZ(RANDOMX_EXE_ARGS) {
+			*ibc.idst -= load64(scratchpad + ibc.imm);
+		}
+
+		static void exe_IMUL_MZ(RANDOMX_EXE_ARGS) {
+			*ibc.idst *= load64(scratchpad + ibc.imm);
+		}
+
+		static void exe_IMULH_MZ(RANDOMX_EXE_ARGS) {
+			*ibc.idst = mulh(*ibc.idst, load64(scratchpad + ibc.imm));
+		}
+
+		static void exe_ISMULH_MZ(RANDOMX_EXE_ARGS) {
+			*ibc.idst = smulh(unsigned64ToSigned2sCompl(*ibc.idst), unsigned64ToSigned2sCompl(load64(scratchpad + ibc.imm)));
+		}
+
+		static void exe_IXOR_MZ(RANDOMX_EXE_ARGS) {
+			*ibc.idst ^= load64(scratchpad + ibc.imm);
+		}
+
+		// Immediate source operand (src == dst or IMUL_RCP)
+		static void exe_ISUB_RI(RANDOMX_EXE_ARGS) {
+			*ibc.idst -= ibc.imm;
+		}
+
+		static void exe_IMUL_RI(RANDOMX_EXE_ARGS) {
+			*ibc.idst *= ibc.imm;
+		}
+
+		static void exe_IXOR_RI(RANDOMX_EXE_ARGS) {
+			*ibc.idst ^= ibc.imm;
+		}
 	protected:
 		static rx_vec_f128 maskRegisterExponentMantissa(ProgramConfiguration& config, rx_vec_f128 x) {
 			const rx_vec_f128 xmantissaMask = rx_set_vec_f128(dynamicMantissaMask, dynamicMantissaMask);
@@ -247,8 +313,9 @@ namespace randomx {
 			nreg = nullptr;
 		}
 
-	private:
 		static const int_reg_t zero;
+
+	private:
 		int registerUsage[RegistersCount] = {};
 		NativeRegisterFile* nreg = nullptr;
 
@@ -70,6 +70,7 @@ namespace randomx {
 		DatasetInitFunc* getDatasetInitFunc() const;
 		uint8_t* getCode() { return code; }
 		size_t getCodeSize();
+		uint8_t* getCodeMemory(size_t& size) const { size = allocatedSize; return code; }
 
 		void enableWriting() const;
 		void enableExecution() const;
@@ -72,6 +72,10 @@ namespace randomx {
 		size_t getCodeSize() {
 			return 0;
 		}
+		uint8_t* getCodeMemory(size_t& size) const {
+			size = 0;
+			return nullptr;
+		}
 		void enableWriting() {}
 		void enableExecution() {}
 	};
@@ -601,6 +601,11 @@ namespace randomx {
 		return CodeSize;
 	}
 
+	uint8_t* JitCompilerRV64::getCodeMemory(size_t& size) const {
+		size = CodeSize;
+		return state.code;
+	}
+
 	JitCompilerRV64::JitCompilerRV64(bool hugePagesEnable, bool) {
 		state.code = static_cast<uint8_t*>(allocExecutableMemory(CodeSize, hugePagesJIT && hugePagesEnable));
 		state.emitAt(LiteralPoolOffset, codeLiterals, sizeLiterals);
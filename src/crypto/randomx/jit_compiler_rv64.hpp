@@ -97,6 +97,7 @@ namespace randomx {
 			return state.code;
 		}
 		size_t getCodeSize();
+		uint8_t* getCodeMemory(size_t& size) const;
 
 		void enableWriting() const;
 		void enableExecution() const;
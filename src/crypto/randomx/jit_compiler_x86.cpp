@@ -200,12 +200,24 @@ namespace randomx {
 	}
 
 	void JitCompilerX86::enableWriting() const {
+		if (isDualMapped()) {
+			return;
+		}
+
+		PROFILE_SCOPE(RandomX_JIT_protect);
+
 		uint8_t* p1 = alignToPage(code, 4096);
 		uint8_t* p2 = code + CodeSize;
 		xmrig::VirtualMemory::protectRW(p1, p2 - p1);
 	}
 
 	void JitCompilerX86::enableExecution() const {
+		if (isDualMapped()) {
+			return;
+		}
+
+		PROFILE_SCOPE(RandomX_JIT_protect);
+
 		uint8_t* p1 = alignToPage(code, 4096);
 		uint8_t* p2 = code + CodeSize;
 		xmrig::VirtualMemory::protectRX(p1, p2 - p1);
@@ -283,16 +295,22 @@ namespace randomx {
 		hasXOP = xmrig::Cpu::info()->hasXOP();
 
 		allocatedSize = initDatasetAVX2 ? (CodeSize * 4) : (CodeSize * 2);
-		allocatedCode = static_cast<uint8_t*>(allocExecutableMemory(allocatedSize,
-#			ifdef XMRIG_SECURE_JIT
-			false
-#			else
-			hugePagesJIT && hugePagesEnable
-#			endif
-		));
+#		ifdef XMRIG_SECURE_JIT
+		// Prefer two views of the same memory (RW and RX), this way W^X costs no mprotect() calls per program
+		allocatedCodeExec = static_cast<uint8_t*>(allocDualMappedMemory(allocatedSize, reinterpret_cast<void**>(&allocatedCode)));
+		if (!allocatedCodeExec) {
+			allocatedCode = static_cast<uint8_t*>(allocExecutableMemory(allocatedSize, false));
+			allocatedCodeExec = allocatedCode;
+		}
+#		else
+		allocatedCode = static_cast<uint8_t*>(allocExecutableMemory(allocatedSize, hugePagesJIT && hugePagesEnable));
+		allocatedCodeExec = allocatedCode;
+#		endif
 
 		// Shift code base address to improve caching - all threads will use different L2/L3 cache sets
-		code = allocatedCode + (codeOffset.fetch_add(codeOffsetIncrement) % CodeSize);
+		const size_t offset = codeOffset.fetch_add(codeOffsetIncrement) % CodeSize;
+		code = allocatedCode + offset;
+		codeExec = allocatedCodeExec + offset;
 
 		memcpy(code, codePrologue, prologueSize);
 		if (hasXOP) {
@@ -306,14 +324,20 @@ namespace randomx {
 		codePosFirst = prologueSize + (hasXOP ? loopLoadXOPSize : loopLoadSize);
 
 #		ifdef XMRIG_FIX_RYZEN
-		mainLoopBounds.first = code + prologueSize;
-		mainLoopBounds.second = code + epilogueOffset;
+		mainLoopBounds.first = codeExec + prologueSize;
+		mainLoopBounds.second = codeExec + epilogueOffset;
 #		endif
 	}
 
 	JitCompilerX86::~JitCompilerX86() {
 		codeOffset.fetch_sub(codeOffsetIncrement);
-		freePagedMemory(allocatedCode, allocatedSize);
+
+		if (isDualMapped()) {
+			freeDualMappedMemory(allocatedCodeExec, allocatedCode, allocatedSize);
+		}
+		else {
+			freePagedMemory(allocatedCode, allocatedSize);
+		}
 	}
 
 	template<size_t N>
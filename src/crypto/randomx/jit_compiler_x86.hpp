@@ -63,7 +63,7 @@ namespace randomx {
 			enableExecution();
 #			endif
 
-			return reinterpret_cast<ProgramFunc*>(code);
+			return reinterpret_cast<ProgramFunc*>(codeExec);
 		}
 
 		inline DatasetInitFunc *getDatasetInitFunc() const {
@@ -71,21 +71,30 @@ namespace randomx {
 			enableExecution();
 #			endif
 
-			return (DatasetInitFunc*)code;
+			return (DatasetInitFunc*)codeExec;
 		}
 
 		uint8_t* getCode() {
 			return code;
 		}
 		size_t getCodeSize();
+
+		inline uint8_t* getCodeMemory(size_t& size) const {
+			size = allocatedSize;
+			return allocatedCodeExec;
+		}
 		void enableWriting() const;
 		void enableExecution() const;
 
+		// Code is written through one mapping and executed through another, page protections never change
+		inline bool isDualMapped() const { return codeExec != code; }
+
 		alignas(64) static InstructionGeneratorX86 engine[256];
 
 	private:
 		int registerUsage[RegistersCount] = {};
 		uint8_t* code = nullptr;
+		uint8_t* codeExec = nullptr;
 		uint32_t codePos = 0;
 		uint32_t codePosFirst = 0;
 		uint32_t vm_flags = 0;
@@ -103,6 +112,7 @@ namespace randomx {
 		bool hasXOP;
 
 		uint8_t* allocatedCode = nullptr;
+		uint8_t* allocatedCodeExec = nullptr;
 		size_t allocatedSize = 0;
 
 		uint8_t* imul_rcp_storage = nullptr;
@@ -33,6 +33,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "crypto/randomx/vm_interpreted_light.hpp"
 #include "crypto/randomx/vm_compiled.hpp"
 #include "crypto/randomx/vm_compiled_light.hpp"
+#include "crypto/randomx/vm_template.hpp"
 #include "crypto/randomx/blake2/blake2.h"
 
 #if defined(_M_X64) || defined(__x86_64__)
@@ -45,6 +46,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "backend/cpu/Cpu.h"
 #include "crypto/common/VirtualMemory.h"
+#include <algorithm>
 #include <mutex>
 
 #include <cassert>
@@ -482,14 +484,21 @@ extern "C" {
 			if (!vm_pool[node]) {
 				vm_pool[node] = (uint8_t*) rx_aligned_alloc(VM_POOL_SIZE, 4096);
 			}
+
+			xmrig::VirtualMemory::membind(vm_pool[node], VM_POOL_SIZE, node);
 		}
 
 
 		void* p = vm_pool[node] + vm_pool_offset[node];
 		size_t vm_size = 0;
 
+		uint32_t type = flags & (RANDOMX_FLAG_FULL_MEM | RANDOMX_FLAG_JIT | RANDOMX_FLAG_HARD_AES | RANDOMX_FLAG_TEMPLATE);
+		if (type & RANDOMX_FLAG_JIT) {
+			type &= ~RANDOMX_FLAG_TEMPLATE;
+		}
+
 		try {
-			switch (flags & (RANDOMX_FLAG_FULL_MEM | RANDOMX_FLAG_JIT | RANDOMX_FLAG_HARD_AES)) {
+			switch (type) {
 				case RANDOMX_FLAG_DEFAULT:
 					vm = new(p) randomx::InterpretedLightVmDefault();
 					vm_size = sizeof(randomx::InterpretedLightVmDefault);
@@ -530,6 +539,26 @@ extern "C" {
 					vm_size = sizeof(randomx::CompiledVmHardAes);
 					break;
 
+				case RANDOMX_FLAG_TEMPLATE:
+					vm = new(p) randomx::TemplateLightVmDefault();
+					vm_size = sizeof(randomx::TemplateLightVmDefault);
+					break;
+
+				case RANDOMX_FLAG_FULL_MEM | RANDOMX_FLAG_TEMPLATE:
+					vm = new(p) randomx::TemplateVmDefault();
+					vm_size = sizeof(randomx::TemplateVmDefault);
+					break;
+
+				case RANDOMX_FLAG_HARD_AES | RANDOMX_FLAG_TEMPLATE:
+					vm = new(p) randomx::TemplateLightVmHardAes();
+					vm_size = sizeof(randomx::TemplateLightVmHardAes);
+					break;
+
+				case RANDOMX_FLAG_FULL_MEM | RANDOMX_FLAG_HARD_AES | RANDOMX_FLAG_TEMPLATE:
+					vm = new(p) randomx::TemplateVmHardAes();
+					vm_size = sizeof(randomx::TemplateVmHardAes);
+					break;
+
 				default:
 					UNREACHABLE;
 			}
@@ -544,6 +573,12 @@ extern "C" {
 
 			vm->setScratchpad(scratchpad);
 			vm->setFlags(flags);
+
+			size_t code_size = 0;
+			void* code = vm->getCodeMemory(code_size);
+			if (code) {
+				xmrig::VirtualMemory::membind(code, code_size, node);
+			}
 		}
 		catch (std::exception &ex) {
 			vm = nullptr;
@@ -571,6 +606,12 @@ extern "C" {
 		machine->setDataset(dataset);
 	}
 
+	void *randomx_vm_code_memory(randomx_vm *machine, size_t *size) {
+		assert(machine != nullptr);
+		assert(size != nullptr);
+		return machine->getCodeMemory(*size);
+	}
+
 	void randomx_destroy_vm(randomx_vm* vm) {
 		vm->~randomx_vm();
 	}
@@ -591,6 +632,36 @@ extern "C" {
 		machine->getFinalResult(output);
 	}
 
+	void randomx_calculate_hash_batch(randomx_vm *machine, const void *const *input, size_t inputSize, void *const *output, size_t count) {
+		assert(machine != nullptr);
+		assert(count == 0 || (input != nullptr && output != nullptr));
+		constexpr size_t kBatch = 8;
+		alignas(16) uint64_t tempHash[kBatch][8];
+		alignas(64) randomx::RegisterFile reg[kBatch];
+		void *seeds[kBatch];
+		const void *regs[kBatch];
+		for (size_t i = 0; i < kBatch; ++i) {
+			seeds[i] = tempHash[i];
+			regs[i] = &reg[i];
+		}
+		for (size_t first = 0; first < count; first += kBatch) {
+			const size_t n = std::min(kBatch, count - first);
+			rx_blake2b_multi(seeds, sizeof(tempHash[0]), input + first, inputSize, n);
+			for (size_t i = 0; i < n; ++i) {
+				machine->initScratchpad(&tempHash[i]);
+				machine->resetRoundingMode();
+				for (uint32_t chain = 0; chain < RandomX_CurrentConfig.ProgramCount - 1; ++chain) {
+					machine->run(&tempHash[i]);
+					rx_blake2b_wrapper::run(tempHash[i], sizeof(tempHash[i]), machine->getRegisterFile(), sizeof(randomx::RegisterFile));
+				}
+				machine->run(&tempHash[i]);
+				machine->hashScratchpad();
+				reg[i] = *machine->getRegisterFile();
+			}
+			rx_blake2b_multi(output + first, RANDOMX_HASH_SIZE, regs, sizeof(randomx::RegisterFile), n);
+		}
+	}
+
 	void randomx_calculate_hash_first(randomx_vm* machine, uint64_t (&tempHash)[8], const void* input, size_t inputSize) {
 		rx_blake2b_wrapper::run(tempHash, sizeof(tempHash), input, inputSize);
 		machine->initScratchpad(tempHash);
@@ -50,6 +50,7 @@ enum randomx_flags {
   RANDOMX_FLAG_JIT = 8,
   RANDOMX_FLAG_1GB_PAGES = 16,
   RANDOMX_FLAG_AMD = 64,
+  RANDOMX_FLAG_TEMPLATE = 128,
 };
 
 
@@ -170,6 +171,7 @@ void randomx_apply_config(const T& config)
 void randomx_set_scratchpad_prefetch_mode(int mode);
 void randomx_set_huge_pages_jit(bool hugePages);
 void randomx_set_optimized_dataset_init(int value);
+void randomx_set_threaded_interpreter(bool enable);
 
 #if defined(__cplusplus)
 extern "C" {
@@ -261,6 +263,8 @@ RANDOMX_EXPORT void randomx_release_dataset(randomx_dataset *dataset);
  *        RANDOMX_FLAG_HARD_AES - virtual machine will use hardware accelerated AES
  *        RANDOMX_FLAG_FULL_MEM - virtual machine will use the full dataset
  *        RANDOMX_FLAG_JIT - virtual machine will use a JIT compiler
+ *        RANDOMX_FLAG_TEMPLATE - virtual machine will chain precompiled instruction handlers instead
+ *          of the interpreter, it doesn't need executable memory (ignored if RANDOMX_FLAG_JIT is set)
  *        The numeric values of the flags are ordered so that a higher value will provide
  *        faster hash calculation and a lower numeric value will provide higher portability.
  *        Using RANDOMX_FLAG_DEFAULT (all flags not set) works on all platforms, but is the slowest.
@@ -297,6 +301,16 @@ RANDOMX_EXPORT void randomx_vm_set_cache(randomx_vm *machine, randomx_cache* cac
 */
 RANDOMX_EXPORT void randomx_vm_set_dataset(randomx_vm *machine, randomx_dataset *dataset);
 
+/**
+ * Returns the memory block which holds the JIT compiled code of a virtual machine.
+ *
+ * @param machine is a pointer to a randomx_vm structure. Must not be NULL.
+ * @param size receives the size of the block in bytes. Must not be NULL.
+ *
+ * @return Pointer to the code memory or NULL if the virtual machine doesn't use JIT.
+*/
+RANDOMX_EXPORT void *randomx_vm_code_memory(randomx_vm *machine, size_t *size);
+
 /**
  * Releases all memory occupied by the randomx_vm structure.
  *
@@ -315,6 +329,19 @@ RANDOMX_EXPORT void randomx_destroy_vm(randomx_vm *machine);
 */
 RANDOMX_EXPORT void randomx_calculate_hash(randomx_vm *machine, const void *input, size_t inputSize, void *output);
 
+/**
+ * Calculates RandomX hash values of several inputs of the same size with one virtual machine.
+ * Same results as randomx_calculate_hash() for each input, but the independent Blake2b
+ * invocations (the scratchpad seeds and the final hashes) go through rx_blake2b_multi.
+ *
+ * @param machine is a pointer to a randomx_vm structure. Must not be NULL.
+ * @param input is an array of count pointers to the memory to be hashed.
+ * @param inputSize is the number of bytes to be hashed, the same for every input.
+ * @param output is an array of count pointers to memory where the hashes will be stored.
+ * @param count is the number of inputs.
+*/
+RANDOMX_EXPORT void randomx_calculate_hash_batch(randomx_vm *machine, const void *const *input, size_t inputSize, void *const *output, size_t count);
+
 RANDOMX_EXPORT void randomx_calculate_hash_first(randomx_vm* machine, uint64_t (&tempHash)[8], const void* input, size_t inputSize);
 RANDOMX_EXPORT void randomx_calculate_hash_next(randomx_vm* machine, uint64_t (&tempHash)[8], const void* nextInput, size_t nextInputSize, void* output);
 
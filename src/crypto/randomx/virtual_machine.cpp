@@ -112,10 +112,15 @@ namespace randomx {
 
 	template<int softAes>
 	void VmBase<softAes>::getFinalResult(void* out) {
-		hashAes1Rx4<softAes>(scratchpad, ScratchpadSize, &reg.a);
+		hashScratchpad();
 		rx_blake2b_wrapper::run(out, RANDOMX_HASH_SIZE, &reg, sizeof(RegisterFile));
 	}
 
+	template<int softAes>
+	void VmBase<softAes>::hashScratchpad() {
+		hashAes1Rx4<softAes>(scratchpad, ScratchpadSize, &reg.a);
+	}
+
 	template<int softAes>
 	void VmBase<softAes>::hashAndFill(void* out, uint64_t (&fill_state)[8]) {
 		if (!softAes) {
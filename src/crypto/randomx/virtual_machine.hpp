@@ -39,6 +39,8 @@ public:
 	virtual ~randomx_vm() = 0;
 	virtual void setScratchpad(uint8_t *scratchpad) = 0;
 	virtual void getFinalResult(void* out) = 0;
+	// First half of getFinalResult(): folds the scratchpad into the register file, which is then hashed with Blake2b
+	virtual void hashScratchpad() = 0;
 	virtual void hashAndFill(void* out, uint64_t (&fill_state)[8]) = 0;
 	virtual void setDataset(randomx_dataset* dataset) { }
 	virtual void setCache(randomx_cache* cache) { }
@@ -46,6 +48,9 @@ public:
 	virtual void run(void* seed) = 0;
 	void resetRoundingMode();
 
+	// Memory with the JIT compiled code, nullptr for VMs without JIT
+	virtual void* getCodeMemory(size_t& size) const { size = 0; return nullptr; }
+
 	void setFlags(uint32_t flags) { vm_flags = flags; }
 	uint32_t getFlags() const { return vm_flags; }
 
@@ -87,6 +92,7 @@ namespace randomx {
 		void setScratchpad(uint8_t *scratchpad) override;
 		void initScratchpad(void* seed) override;
 		void getFinalResult(void* out) override;
+		void hashScratchpad() override;
 		void hashAndFill(void* out, uint64_t (&fill_state)[8]) override;
 
 	protected:
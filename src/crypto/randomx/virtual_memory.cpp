@@ -43,6 +43,12 @@ void* allocExecutableMemory(std::size_t bytes, bool hugePages) {
 }
 
 
+// Returns the executable view and stores the writable view of the same memory in writable, nullptr if not supported
+void* allocDualMappedMemory(std::size_t bytes, void** writable) {
+    return xmrig::VirtualMemory::allocateDualMappedMemory(bytes, writable);
+}
+
+
 void* allocLargePagesMemory(std::size_t bytes) {
     void *mem = xmrig::VirtualMemory::allocateLargePagesMemory(bytes);
     if (mem == nullptr) {
@@ -56,3 +62,8 @@ void* allocLargePagesMemory(std::size_t bytes) {
 void freePagedMemory(void* ptr, std::size_t bytes) {
     xmrig::VirtualMemory::freeLargePagesMemory(ptr, bytes);
 }
+
+
+void freeDualMappedMemory(void* ptr, void* writable, std::size_t bytes) {
+    xmrig::VirtualMemory::freeDualMappedMemory(ptr, writable, bytes);
+}
@@ -47,6 +47,7 @@ namespace randomx {
 
 		void setDataset(randomx_dataset* dataset) override;
 		void run(void* seed) override;
+		void* getCodeMemory(size_t& size) const override { return compiler.getCodeMemory(size); }
 
 		using VmBase<softAes>::mem;
 		using VmBase<softAes>::program;
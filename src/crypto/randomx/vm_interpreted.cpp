@@ -54,7 +54,7 @@ namespace randomx {
 		for(unsigned i = 0; i < RegisterCountFlt; ++i)
 			nreg.a[i] = rx_load_vec_f128(&reg.a[i].lo);
 
-		compileProgram(program, bytecode, nreg);
+		prepareProgram(nreg);
 
 		uint32_t spAddr0 = mem.mx;
 		uint32_t spAddr1 = mem.ma;
@@ -75,7 +75,7 @@ namespace randomx {
 			for (unsigned i = 0; i < RegisterCountFlt; ++i)
 				nreg.e[i] = maskRegisterExponentMantissa(config, rx_cvt_packed_int_vec_f128(scratchpad + spAddr1 + 8 * (RegisterCountFlt + i)));
 
-			executeBytecode(bytecode, scratchpad, config);
+			executeProgram(nreg);
 
 			mem.mx ^= nreg.r[config.readReg2] ^ nreg.r[config.readReg3];
 			mem.mx &= CacheLineAlignMask;
@@ -108,6 +108,26 @@ namespace randomx {
 		cleanup();
 	}
 
+	template<int softAes>
+	void InterpretedVm<softAes>::prepareProgram(NativeRegisterFile& nreg) {
+		compileProgram(program, bytecode, nreg);
+
+		threaded = isThreaded();
+		if (threaded) {
+			prepareThreaded(bytecode);
+		}
+	}
+
+	template<int softAes>
+	void InterpretedVm<softAes>::executeProgram(NativeRegisterFile&) {
+		if (threaded) {
+			executeBytecodeThreaded(bytecode, scratchpad, config);
+		}
+		else {
+			executeBytecode(bytecode, scratchpad, config);
+		}
+	}
+
 	template<int softAes>
 	void InterpretedVm<softAes>::datasetRead(uint64_t address, int_reg_t(&r)[RegistersCount]) {
 		uint64_t* datasetLine = (uint64_t*)(mem.memory + address);
@@ -59,10 +59,18 @@ namespace randomx {
 		virtual void datasetRead(uint64_t blockNumber, int_reg_t(&r)[RegistersCount]);
 		virtual void datasetPrefetch(uint64_t blockNumber);
 
+		// Translates the current program before the first iteration and runs it once per iteration,
+		// the program loop in execute() is shared with VMs which use their own bytecode format
+		virtual void prepareProgram(NativeRegisterFile& nreg);
+		virtual void executeProgram(NativeRegisterFile& nreg);
+
+		// One extra entry for the END marker of the threaded interpreter
+		InstructionByteCode bytecode[RANDOMX_PROGRAM_MAX_SIZE + 1];
+
 	private:
 		void execute();
 
-		InstructionByteCode bytecode[RANDOMX_PROGRAM_MAX_SIZE];
+		bool threaded = false;
 	};
 
 	using InterpretedVmDefault = InterpretedVm<1>;
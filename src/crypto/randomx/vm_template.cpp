@@ -0,0 +1,288 @@
+/*
+Copyright (c) 2018-2019, tevador <tevador@gmail.com>
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+	* Redistributions of source code must retain the above copyright
+	  notice, this list of conditions and the following disclaimer.
+	* Redistributions in binary form must reproduce the above copyright
+	  notice, this list of conditions and the following disclaimer in the
+	  documentation and/or other materials provided with the distribution.
+	* Neither the name of the copyright holder nor the
+	  names of its contributors may be used to endorse or promote products
+	  derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "crypto/randomx/vm_template.hpp"
+#include "crypto/randomx/intrin_portable.h"
+
+namespace randomx {
+
+#ifdef RANDOMX_THREADED_DISPATCH
+
+	// op, destination register file, destination count, source kind, source count
+	//   R - integer register, slot 8 is the immediate (src == dst or IMUL_RCP)
+	//   M - integer register used as a memory address, slot 8 is a constant address (src == dst)
+	//   A - floating point "a" register
+	//   N - no source operand
+#define TEMPLATE_OPS(X) \
+	X(IADD_RS,  r, 8, R, 8) \
+	X(IADD_M,   r, 8, M, 9) \
+	X(ISUB_R,   r, 8, R, 9) \
+	X(ISUB_M,   r, 8, M, 9) \
+	X(IMUL_R,   r, 8, R, 9) \
+	X(IMUL_M,   r, 8, M, 9) \
+	X(IMULH_R,  r, 8, R, 8) \
+	X(IMULH_M,  r, 8, M, 9) \
+	X(ISMULH_R, r, 8, R, 8) \
+	X(ISMULH_M, r, 8, M, 9) \
+	X(INEG_R,   r, 8, N, 1) \
+	X(IXOR_R,   r, 8, R, 9) \
+	X(IXOR_M,   r, 8, M, 9) \
+	X(IROR_R,   r, 8, R, 9) \
+	X(IROL_R,   r, 8, R, 9) \
+	X(ISWAP_R,  r, 8, R, 8) \
+	X(FSWAP_F,  f, 4, N, 1) \
+	X(FSWAP_E,  e, 4, N, 1) \
+	X(FADD_R,   f, 4, A, 4) \
+	X(FADD_M,   f, 4, M, 9) \
+	X(FSUB_R,   f, 4, A, 4) \
+	X(FSUB_M,   f, 4, M, 9) \
+	X(FSCAL_R,  f, 4, N, 1) \
+	X(FMUL_R,   e, 4, A, 4) \
+	X(FDIV_M,   e, 4, M, 9) \
+	X(FSQRT_R,  e, 4, N, 1) \
+	X(CBRANCH,  r, 8, N, 1) \
+	X(CFROUND,  r, 8, N, 1) \
+	X(ISTORE,   r, 8, R, 8) \
+	X(NOP,      r, 1, N, 1)
+
+#define TPL_DST_1(F, ...) F(0, __VA_ARGS__)
+#define TPL_DST_4(F, ...) F(0, __VA_ARGS__) F(1, __VA_ARGS__) F(2, __VA_ARGS__) F(3, __VA_ARGS__)
+#define TPL_DST_8(F, ...) TPL_DST_4(F, __VA_ARGS__) F(4, __VA_ARGS__) F(5, __VA_ARGS__) F(6, __VA_ARGS__) F(7, __VA_ARGS__)
+
+#define TPL_SRC_1(F, d, ...) F(d, 0, __VA_ARGS__)
+#define TPL_SRC_4(F, d, ...) F(d, 0, __VA_ARGS__) F(d, 1, __VA_ARGS__) F(d, 2, __VA_ARGS__) F(d, 3, __VA_ARGS__)
+#define TPL_SRC_8(F, d, ...) TPL_SRC_4(F, d, __VA_ARGS__) F(d, 4, __VA_ARGS__) F(d, 5, __VA_ARGS__) F(d, 6, __VA_ARGS__) F(d, 7, __VA_ARGS__)
+#define TPL_SRC_9(F, d, ...) TPL_SRC_8(F, d, __VA_ARGS__) F(d, 8, __VA_ARGS__)
+
+#define TPL_R_0 r0
+#define TPL_R_1 r1
+#define TPL_R_2 r2
+#define TPL_R_3 r3
+#define TPL_R_4 r4
+#define TPL_R_5 r5
+#define TPL_R_6 r6
+#define TPL_R_7 r7
+#define TPL_R_8 ins->imm
+
+#define TPL_M_0 r0
+#define TPL_M_1 r1
+#define TPL_M_2 r2
+#define TPL_M_3 r3
+#define TPL_M_4 r4
+#define TPL_M_5 r5
+#define TPL_M_6 r6
+#define TPL_M_7 r7
+#define TPL_M_8 0
+
+#define TPL_A_0 a0
+#define TPL_A_1 a1
+#define TPL_A_2 a2
+#define TPL_A_3 a3
+
+#define TPL_N_0 0
+
+#define TPL_ADDR(S)   (scratchpad + (((S) + ins->imm) & ins->memMask))
+#define TPL_LOAD(S)   load64(TPL_ADDR(S))
+#define TPL_LOADF(S)  rx_cvt_packed_int_vec_f128(TPL_ADDR(S))
+
+#define TPL_OP_IADD_RS(D, S)  D += ((S) << ins->shift) + ins->imm
+#define TPL_OP_IADD_M(D, S)   D += TPL_LOAD(S)
+#define TPL_OP_ISUB_R(D, S)   D -= S
+#define TPL_OP_ISUB_M(D, S)   D -= TPL_LOAD(S)
+#define TPL_OP_IMUL_R(D, S)   D *= S
+#define TPL_OP_IMUL_M(D, S)   D *= TPL_LOAD(S)
+#define TPL_OP_IMULH_R(D, S)  D = mulh(D, S)
+#define TPL_OP_IMULH_M(D, S)  D = mulh(D, TPL_LOAD(S))
+#define TPL_OP_ISMULH_R(D, S) D = smulh(unsigned64ToSigned2sCompl(D), unsigned64ToSigned2sCompl(S))
+#define TPL_OP_ISMULH_M(D, S) D = smulh(unsigned64ToSigned2sCompl(D), unsigned64ToSigned2sCompl(TPL_LOAD(S)))
+#define TPL_OP_INEG_R(D, S)   D = ~D + 1
+#define TPL_OP_IXOR_R(D, S)   D ^= S
+#define TPL_OP_IXOR_M(D, S)   D ^= TPL_LOAD(S)
+#define TPL_OP_IROR_R(D, S)   D = rotr64(D, (S) & 63)
+#define TPL_OP_IROL_R(D, S)   D = rotl64(D, (S) & 63)
+#define TPL_OP_ISWAP_R(D, S)  { const uint64_t temp = S; S = D; D = temp; }
+#define TPL_OP_FSWAP_F(D, S)  D = rx_swap_vec_f128(D)
+#define TPL_OP_FSWAP_E(D, S)  D = rx_swap_vec_f128(D)
+#define TPL_OP_FADD_R(D, S)   D = rx_add_vec_f128(D, S)
+#define TPL_OP_FADD_M(D, S)   D = rx_add_vec_f128(D, TPL_LOADF(S))
+#define TPL_OP_FSUB_R(D, S)   D = rx_sub_vec_f128(D, S)
+#define TPL_OP_FSUB_M(D, S)   D = rx_sub_vec_f128(D, TPL_LOADF(S))
+#define TPL_OP_FSCAL_R(D, S)  D = rx_xor_vec_f128(D, scaleMask)
+#define TPL_OP_FMUL_R(D, S)   D = rx_mul_vec_f128(D, S)
+#define TPL_OP_FDIV_M(D, S)   D = rx_div_vec_f128(D, rx_or_vec_f128(rx_and_vec_f128(TPL_LOADF(S), mantissaMask), exponentMask))
+#define TPL_OP_FSQRT_R(D, S)  D = rx_sqrt_vec_f128(D)
+#define TPL_OP_CBRANCH(D, S)  D += ins->imm; if ((D & ins->memMask) == 0) { ins = code + ins->target; goto *ins->handler; }
+#define TPL_OP_CFROUND(D, S)  rx_set_rounding_mode(rotr64(D, static_cast<uint32_t>(ins->imm)) % 4)
+#define TPL_OP_ISTORE(D, S)   store64(TPL_ADDR(D), S)
+#define TPL_OP_NOP(D, S)
+
+#define TPL_NEXT() ++ins; goto *ins->handler
+
+#define TPL_HANDLER(d, s, op, dreg, kind) op_##op##_##d##_##s: TPL_OP_##op(dreg##d, TPL_##kind##_##s); TPL_NEXT();
+#define TPL_HANDLER_ROW(d, op, dreg, kind, ns) TPL_SRC_##ns(TPL_HANDLER, d, op, dreg, kind)
+#define TPL_HANDLERS(op, dreg, nd, kind, ns) TPL_DST_##nd(TPL_HANDLER_ROW, op, dreg, kind, ns)
+
+#define TPL_ENTRY(d, s, op, dreg, kind) &&op_##op##_##d##_##s,
+#define TPL_ENTRY_ROW(d, op, dreg, kind, ns) { TPL_SRC_##ns(TPL_ENTRY, d, op, dreg, kind) },
+#define TPL_ENTRIES(op, dreg, nd, kind, ns) { TPL_DST_##nd(TPL_ENTRY_ROW, op, dreg, kind, ns) },
+
+#define TPL_FIELD(op, dreg, nd, kind, ns) const void* op[nd][ns];
+
+	struct TemplateHandlers {
+		TEMPLATE_OPS(TPL_FIELD)
+		const void* END;
+	};
+
+	// Runs a translated program, returns the handler table when called with code == nullptr
+	static const TemplateHandlers* executeTemplate(const TemplateInstruction* code, NativeRegisterFile* nreg, uint8_t* scratchpad, const ProgramConfiguration* config) {
+		static const TemplateHandlers handlers = {
+			TEMPLATE_OPS(TPL_ENTRIES)
+			&&op_END
+		};
+
+		if (code == nullptr) {
+			return &handlers;
+		}
+
+		uint64_t r0 = nreg->r[0], r1 = nreg->r[1], r2 = nreg->r[2], r3 = nreg->r[3];
+		uint64_t r4 = nreg->r[4], r5 = nreg->r[5], r6 = nreg->r[6], r7 = nreg->r[7];
+
+		rx_vec_f128 f0 = nreg->f[0], f1 = nreg->f[1], f2 = nreg->f[2], f3 = nreg->f[3];
+		rx_vec_f128 e0 = nreg->e[0], e1 = nreg->e[1], e2 = nreg->e[2], e3 = nreg->e[3];
+		const rx_vec_f128 a0 = nreg->a[0], a1 = nreg->a[1], a2 = nreg->a[2], a3 = nreg->a[3];
+
+		const rx_vec_f128 scaleMask    = rx_set1_vec_f128(0x80F0000000000000);
+		const rx_vec_f128 mantissaMask = rx_set_vec_f128(dynamicMantissaMask, dynamicMantissaMask);
+		const rx_vec_f128 exponentMask = rx_load_vec_f128((const double*)&config->eMask);
+
+		const TemplateInstruction* ins = code;
+		goto *ins->handler;
+
+		TEMPLATE_OPS(TPL_HANDLERS)
+
+	op_END:
+		nreg->r[0] = r0; nreg->r[1] = r1; nreg->r[2] = r2; nreg->r[3] = r3;
+		nreg->r[4] = r4; nreg->r[5] = r5; nreg->r[6] = r6; nreg->r[7] = r7;
+
+		nreg->f[0] = f0; nreg->f[1] = f1; nreg->f[2] = f2; nreg->f[3] = f3;
+		nreg->e[0] = e0; nreg->e[1] = e1; nreg->e[2] = e2; nreg->e[3] = e3;
+
+		return nullptr;
+	}
+
+	template<class Base>
+	void TemplateVm<Base>::prepareProgram(NativeRegisterFile& nreg) {
+		this->compileProgram(this->program, this->bytecode, nreg);
+		translate(nreg);
+	}
+
+	template<class Base>
+	void TemplateVm<Base>::executeProgram(NativeRegisterFile& nreg) {
+		executeTemplate(code, &nreg, this->scratchpad, &this->config);
+	}
+
+	template<class Base>
+	void TemplateVm<Base>::translate(const NativeRegisterFile& nreg) {
+		static const TemplateHandlers* h = executeTemplate(nullptr, nullptr, nullptr, nullptr);
+
+		for (unsigned i = 0; i < RandomX_CurrentConfig.ProgramSize; ++i) {
+			const InstructionByteCode& ibc = this->bytecode[i];
+			TemplateInstruction& ins = code[i];
+
+			// Register operands are turned back into indices, the immediate and the zero address both map to slot 8
+			const int dst = static_cast<int>(ibc.idst - nreg.r);
+			const int src = (ibc.isrc == &ibc.imm || ibc.isrc == &BytecodeMachine::zero) ? 8 : static_cast<int>(ibc.isrc - nreg.r);
+			const int f = static_cast<int>(ibc.fdst - nreg.f);
+			const int e = static_cast<int>(ibc.fdst - nreg.e);
+			const int a = static_cast<int>(ibc.fsrc - nreg.a);
+
+			ins.imm     = ibc.imm;
+			ins.memMask = ibc.memMask;
+			ins.shift   = ibc.shift;
+
+			switch (ibc.type) {
+			case InstructionType::IADD_RS:  ins.handler = h->IADD_RS[dst][src]; break;
+			case InstructionType::IADD_M:   ins.handler = h->IADD_M[dst][src]; break;
+			case InstructionType::ISUB_R:   ins.handler = h->ISUB_R[dst][src]; break;
+			case InstructionType::ISUB_M:   ins.handler = h->ISUB_M[dst][src]; break;
+			case InstructionType::IMUL_R:   ins.handler = h->IMUL_R[dst][src]; break;
+			case InstructionType::IMUL_M:   ins.handler = h->IMUL_M[dst][src]; break;
+			case InstructionType::IMULH_R:  ins.handler = h->IMULH_R[dst][src]; break;
+			case InstructionType::IMULH_M:  ins.handler = h->IMULH_M[dst][src]; break;
+			case InstructionType::ISMULH_R: ins.handler = h->ISMULH_R[dst][src]; break;
+			case InstructionType::ISMULH_M: ins.handler = h->ISMULH_M[dst][src]; break;
+			case InstructionType::INEG_R:   ins.handler = h->INEG_R[dst][0]; break;
+			case InstructionType::IXOR_R:   ins.handler = h->IXOR_R[dst][src]; break;
+			case InstructionType::IXOR_M:   ins.handler = h->IXOR_M[dst][src]; break;
+			case InstructionType::IROR_R:   ins.handler = h->IROR_R[dst][src]; break;
+			case InstructionType::IROL_R:   ins.handler = h->IROL_R[dst][src]; break;
+			case InstructionType::ISWAP_R:  ins.handler = h->ISWAP_R[dst][src]; break;
+			case InstructionType::FSWAP_R:
+				ins.handler = (f >= 0 && f < RegisterCountFlt) ? h->FSWAP_F[f][0] : h->FSWAP_E[e][0];
+				break;
+			case InstructionType::FADD_R:   ins.handler = h->FADD_R[f][a]; break;
+			case InstructionType::FADD_M:   ins.handler = h->FADD_M[f][src]; break;
+			case InstructionType::FSUB_R:   ins.handler = h->FSUB_R[f][a]; break;
+			case InstructionType::FSUB_M:   ins.handler = h->FSUB_M[f][src]; break;
+			case InstructionType::FSCAL_R:  ins.handler = h->FSCAL_R[f][0]; break;
+			case InstructionType::FMUL_R:   ins.handler = h->FMUL_R[e][a]; break;
+			case InstructionType::FDIV_M:   ins.handler = h->FDIV_M[e][src]; break;
+			case InstructionType::FSQRT_R:  ins.handler = h->FSQRT_R[e][0]; break;
+			case InstructionType::CBRANCH:
+				ins.handler = h->CBRANCH[dst][0];
+				// the interpreter jumps to target and then increments pc, a target of -1 means the first instruction
+				ins.target = ibc.target + 1;
+				break;
+			case InstructionType::CFROUND:  ins.handler = h->CFROUND[src][0]; break;
+			case InstructionType::ISTORE:   ins.handler = h->ISTORE[dst][src]; break;
+			default:                        ins.handler = h->NOP[0][0]; break;
+			}
+		}
+
+		code[RandomX_CurrentConfig.ProgramSize].handler = h->END;
+	}
+
+#else
+
+	template<class Base>
+	void TemplateVm<Base>::prepareProgram(NativeRegisterFile& nreg) {
+		Base::prepareProgram(nreg);
+	}
+
+	template<class Base>
+	void TemplateVm<Base>::executeProgram(NativeRegisterFile& nreg) {
+		Base::executeProgram(nreg);
+	}
+
+#endif
+
+	template class TemplateVm<InterpretedVm<false>>;
+	template class TemplateVm<InterpretedVm<true>>;
+	template class TemplateVm<InterpretedLightVm<false>>;
+	template class TemplateVm<InterpretedLightVm<true>>;
+}
@@ -0,0 +1,72 @@
+/*
+Copyright (c) 2018-2019, tevador <tevador@gmail.com>
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+	* Redistributions of source code must retain the above copyright
+	  notice, this list of conditions and the following disclaimer.
+	* Redistributions in binary form must reproduce the above copyright
+	  notice, this list of conditions and the following disclaimer in the
+	  documentation and/or other materials provided with the distribution.
+	* Neither the name of the copyright holder nor the
+	  names of its contributors may be used to endorse or promote products
+	  derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#include <new>
+#include "crypto/randomx/vm_interpreted.hpp"
+#include "crypto/randomx/vm_interpreted_light.hpp"
+
+namespace randomx {
+
+	// One entry of a translated program: the address of a precompiled handler stub which is
+	// specialised for the instruction and its registers, plus the operands it can't have baked in
+	struct TemplateInstruction {
+		const void* handler;
+		uint64_t imm;
+		uint32_t memMask;
+		union {
+			int16_t target;
+			uint16_t shift;
+		};
+	};
+
+	// VM which doesn't need writable and executable memory: programs are translated into tables of
+	// handler addresses (kept in data memory) and executed by chaining read-only handler stubs with
+	// the integer and floating point registers held in machine registers for the whole program
+	template<class Base>
+	class TemplateVm : public Base {
+	public:
+		void* operator new(size_t, void* ptr) { return ptr; }
+		void operator delete(void*) {}
+
+	protected:
+		void prepareProgram(NativeRegisterFile& nreg) override;
+		void executeProgram(NativeRegisterFile& nreg) override;
+
+	private:
+		void translate(const NativeRegisterFile& nreg);
+
+		TemplateInstruction code[RANDOMX_PROGRAM_MAX_SIZE + 1];
+	};
+
+	using TemplateVmDefault = TemplateVm<InterpretedVm<1>>;
+	using TemplateVmHardAes = TemplateVm<InterpretedVm<0>>;
+	using TemplateLightVmDefault = TemplateVm<InterpretedLightVm<1>>;
+	using TemplateLightVmHardAes = TemplateVm<InterpretedLightVm<0>>;
+}
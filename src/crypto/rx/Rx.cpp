@@ -23,6 +23,7 @@
 #include "backend/cpu/CpuThreads.h"
 #include "crypto/rx/RxConfig.h"
 #include "crypto/rx/RxQueue.h"
+#include "crypto/rx/RxVm.h"
 #include "crypto/randomx/randomx.h"
 #include "crypto/randomx/aes_hash.hpp"
 
@@ -93,6 +94,7 @@ void xmrig::Rx::init(IRxListener *listener)
 
 void (*rx_blake2b_compress)(blake2b_state* S, const uint8_t * block) = rx_blake2b_compress_integer;
 int (*rx_blake2b)(void* out, size_t outlen, const void* in, size_t inlen) = rx_blake2b_default;
+void (*rx_blake2b_multi)(void* const* out, size_t outlen, const void* const* in, size_t inlen, size_t count) = rx_blake2b_multi_default;
 
 
 template<typename T>
@@ -135,6 +137,8 @@ bool xmrig::Rx::init(const T &seed, const RxConfig &config, const CpuConfig &cpu
     randomx_set_scratchpad_prefetch_mode(config.scratchpadPrefetchMode());
     randomx_set_huge_pages_jit(cpu.isHugePagesJit());
     randomx_set_optimized_dataset_init(config.initDatasetAVX2());
+    randomx_set_threaded_interpreter(config.isThreadedInterpreter());
+    RxVm::setJitMode(config.jitMode());
 
     if (!osInitialized) {
 #       ifdef XMRIG_FIX_RYZEN
@@ -154,6 +158,13 @@ bool xmrig::Rx::init(const T &seed, const RxConfig &config, const CpuConfig &cpu
 #if     defined(XMRIG_FEATURE_AVX2)
         if (Cpu::info()->has(ICpuInfo::FLAG_AVX2)) {
             rx_blake2b = blake2b_avx2;
+            rx_blake2b_multi = rx_blake2b_multi_avx2;
+        }
+#       endif
+
+#       if defined(XMRIG_FEATURE_AVX512F)
+        if (Cpu::info()->has(ICpuInfo::FLAG_AVX512F)) {
+            rx_blake2b_multi = rx_blake2b_multi_avx512;
         }
 #       endif
 
@@ -26,6 +26,7 @@
 
 
 #include "crypto/rx/RxCache.h"
+#include "crypto/rx/RxVm.h"
 #include "crypto/common/VirtualMemory.h"
 #include "crypto/randomx/randomx.h"
 
@@ -85,7 +86,9 @@ void xmrig::RxCache::create(uint8_t *memory)
         return;
     }
 
-    m_cache = randomx_create_cache(RANDOMX_FLAG_JIT, memory);
+    if (RxVm::jitMode() == RxConfig::JitAuto) {
+        m_cache = randomx_create_cache(RANDOMX_FLAG_JIT, memory);
+    }
 
     if (!m_cache) {
         m_jit   = false;
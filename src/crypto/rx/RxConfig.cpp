@@ -37,12 +37,14 @@ namespace xmrig {
 const char *RxConfig::kInit                     = "init";
 const char *RxConfig::kInitAVX2                 = "init-avx2";
 const char *RxConfig::kField                    = "randomx";
+const char *RxConfig::kJit                      = "jit";
 const char *RxConfig::kMode                     = "mode";
 const char *RxConfig::kOneGbPages               = "1gb-pages";
 const char *RxConfig::kRdmsr                    = "rdmsr";
 const char *RxConfig::kWrmsr                    = "wrmsr";
 const char *RxConfig::kScratchpadPrefetchMode   = "scratchpad_prefetch_mode";
 const char *RxConfig::kCacheQoS                 = "cache_qos";
+const char *RxConfig::kThreadedInterpreter      = "threaded-interpreter";
 
 #ifdef XMRIG_FEATURE_HWLOC
 const char *RxConfig::kNUMA                     = "numa";
@@ -50,6 +52,7 @@ const char *RxConfig::kNUMA                     = "numa";
 
 
 static const std::array<const char *, RxConfig::ModeMax> modeNames = { "auto", "fast", "light" };
+static const std::array<const char *, RxConfig::JitMax> jitModeNames = { "auto", "template", "interpreter" };
 
 
 #ifdef XMRIG_FEATURE_MSR
@@ -88,6 +91,8 @@ bool xmrig::RxConfig::read(const rapidjson::Value &value)
 #       endif
 
         m_cacheQoS = Json::getBool(value, kCacheQoS, m_cacheQoS);
+        m_threadedInterpreter = Json::getBool(value, kThreadedInterpreter, m_threadedInterpreter);
+        m_jitMode = readJitMode(Json::getValue(value, kJit));
 
 #       ifdef XMRIG_OS_LINUX
         m_oneGbPages = Json::getBool(value, kOneGbPages, m_oneGbPages);
@@ -158,6 +163,8 @@ rapidjson::Value xmrig::RxConfig::toJSON(rapidjson::Document &doc) const
 #   endif
 
     obj.AddMember(StringRef(kCacheQoS), m_cacheQoS, allocator);
+    obj.AddMember(StringRef(kThreadedInterpreter), m_threadedInterpreter, allocator);
+    obj.AddMember(StringRef(kJit), StringRef(jitModeName()), allocator);
 
 #   ifdef XMRIG_FEATURE_HWLOC
     if (!m_nodeset.empty()) {
@@ -192,6 +199,12 @@ std::vector<uint32_t> xmrig::RxConfig::nodeset() const
 #endif
 
 
+const char *xmrig::RxConfig::jitModeName() const
+{
+    return jitModeNames[m_jitMode];
+}
+
+
 const char *xmrig::RxConfig::modeName() const
 {
     return modeNames[m_mode];
@@ -297,3 +310,19 @@ xmrig::RxConfig::Mode xmrig::RxConfig::readMode(const rapidjson::Value &value)
 
     return AutoMode;
 }
+
+
+xmrig::RxConfig::JitMode xmrig::RxConfig::readJitMode(const rapidjson::Value &value)
+{
+    if (value.IsString()) {
+        auto mode = value.GetString();
+
+        for (size_t i = 0; i < jitModeNames.size(); i++) {
+            if (strcasecmp(mode, jitModeNames[i]) == 0) {
+                return static_cast<JitMode>(i);
+            }
+        }
+    }
+
+    return JitAuto;
+}
@@ -44,6 +44,13 @@ public:
         ModeMax
     };
 
+    enum JitMode : uint32_t {
+        JitAuto,
+        JitTemplate,
+        JitInterpreter,
+        JitMax
+    };
+
     enum ScratchpadPrefetchMode : uint32_t {
         ScratchpadPrefetchOff,
         ScratchpadPrefetchT0,
@@ -56,10 +63,12 @@ public:
     static const char *kField;
     static const char *kInit;
     static const char *kInitAVX2;
+    static const char *kJit;
     static const char *kMode;
     static const char *kOneGbPages;
     static const char *kRdmsr;
     static const char *kScratchpadPrefetchMode;
+    static const char *kThreadedInterpreter;
     static const char *kWrmsr;
 
 #   ifdef XMRIG_FEATURE_HWLOC
@@ -75,14 +84,17 @@ public:
     inline std::vector<uint32_t> nodeset() const { return std::vector<uint32_t>(); }
 #   endif
 
+    const char *jitModeName() const;
     const char *modeName() const;
     uint32_t threads(uint32_t limit = 100) const;
 
     inline int initDatasetAVX2() const  { return m_initDatasetAVX2; }
     inline bool isOneGbPages() const    { return m_oneGbPages; }
+    inline bool isThreadedInterpreter() const { return m_threadedInterpreter; }
     inline bool rdmsr() const           { return m_rdmsr; }
     inline bool wrmsr() const           { return m_wrmsr; }
     inline bool cacheQoS() const        { return m_cacheQoS; }
+    inline JitMode jitMode() const      { return m_jitMode; }
     inline Mode mode() const            { return m_mode; }
 
     inline ScratchpadPrefetchMode scratchpadPrefetchMode() const { return m_scratchpadPrefetchMode; }
@@ -105,12 +117,15 @@ private:
 
     bool m_cacheQoS = false;
 
+    static JitMode readJitMode(const rapidjson::Value &value);
     static Mode readMode(const rapidjson::Value &value);
 
     bool m_oneGbPages     = false;
     bool m_rdmsr          = true;
+    bool m_threadedInterpreter = true;
     int m_threads         = -1;
     int m_initDatasetAVX2 = -1;
+    JitMode m_jitMode     = JitAuto;
     Mode m_mode           = AutoMode;
 
     ScratchpadPrefetchMode m_scratchpadPrefetchMode = ScratchpadPrefetchT0;
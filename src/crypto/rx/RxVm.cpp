@@ -20,9 +20,37 @@
 
 #include "crypto/randomx/randomx.h"
 #include "backend/cpu/Cpu.h"
+#include "base/io/log/Log.h"
+#include "base/io/log/Tags.h"
+#include "crypto/common/VirtualMemory.h"
 #include "crypto/rx/RxCache.h"
 #include "crypto/rx/RxDataset.h"
 #include "crypto/rx/RxVm.h"
+#include "crypto/randomx/configuration.h"
+
+
+#include <cstdio>
+
+
+xmrig::RxConfig::JitMode xmrig::RxVm::m_jitMode = xmrig::RxConfig::JitAuto;
+
+
+namespace xmrig {
+
+
+static const char *nodeName(int64_t node, char *buf)
+{
+    if (node < 0) {
+        return "n/a";
+    }
+
+    snprintf(buf, 16, "#%u", static_cast<uint32_t>(node));
+
+    return buf;
+}
+
+
+} // namespace xmrig
 
 
 randomx_vm *xmrig::RxVm::create(RxDataset *dataset, uint8_t *scratchpad, bool softAes, const Assembly &assembly, uint32_t node)
@@ -45,9 +73,12 @@ randomx_vm *xmrig::RxVm::create(RxDataset *dataset, uint8_t *scratchpad, bool so
         flags |= RANDOMX_FLAG_FULL_MEM;
     }
 
-    if (!dataset->cache() || dataset->cache()->isJIT()) {
+    if (m_jitMode == RxConfig::JitAuto && (!dataset->cache() || dataset->cache()->isJIT())) {
         flags |= RANDOMX_FLAG_JIT;
     }
+    else if (m_jitMode != RxConfig::JitInterpreter) {
+        flags |= RANDOMX_FLAG_TEMPLATE;
+    }
 
     const auto asmId = assembly == Assembly::AUTO ? Cpu::info()->assembly() : assembly.id();
     if ((asmId == Assembly::RYZEN) || (asmId == Assembly::BULLDOZER)) {
@@ -64,3 +95,31 @@ void xmrig::RxVm::destroy(randomx_vm* vm)
         randomx_destroy_vm(vm);
     }
 }
+
+
+void xmrig::RxVm::printPlacement(randomx_vm *vm, const uint8_t *scratchpad, size_t id, uint32_t node)
+{
+    if (!vm || Cpu::info()->nodes() < 2) {
+        return;
+    }
+
+    size_t codeSize  = 0;
+    void *code       = randomx_vm_code_memory(vm, &codeSize);
+
+    const int64_t vmNode         = VirtualMemory::nodeOf(vm, 4096);
+    const int64_t codeNode       = VirtualMemory::nodeOf(code, codeSize);
+    const int64_t scratchpadNode = VirtualMemory::nodeOf(scratchpad, RANDOMX_SCRATCHPAD_L3_MAX_SIZE);
+    const size_t codePageSize    = code ? VirtualMemory::pageSize(code) : 0;
+
+    const bool remote = (vmNode >= 0 && vmNode != node) || (codeNode >= 0 && codeNode != node) || (scratchpadNode >= 0 && scratchpadNode != node);
+
+    char buf[3][16];
+    if (remote) {
+        LOG_WARN("%s" YELLOW_BOLD("thread #%zu memory is not on NUMA node #%u") " vm %s jit %s (%zu KB pages) scratchpad %s",
+                 Tags::randomx(), id, node, nodeName(vmNode, buf[0]), nodeName(codeNode, buf[1]), codePageSize / 1024, nodeName(scratchpadNode, buf[2]));
+    }
+    else {
+        LOG_VERBOSE("%s" CYAN_BOLD("#%u ") "thread #%zu vm %s jit %s (%zu KB pages) scratchpad %s",
+                    Tags::randomx(), node, id, nodeName(vmNode, buf[0]), nodeName(codeNode, buf[1]), codePageSize / 1024, nodeName(scratchpadNode, buf[2]));
+    }
+}
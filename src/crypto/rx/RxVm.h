@@ -21,6 +21,9 @@
 #define XMRIG_RX_VM_H
 
 
+#include "crypto/rx/RxConfig.h"
+
+
 #include <cstdint>
 
 
@@ -40,6 +43,13 @@ class RxVm
 public:
     static randomx_vm *create(RxDataset *dataset, uint8_t *scratchpad, bool softAes, const Assembly &assembly, uint32_t node);
     static void destroy(randomx_vm *vm);
+    static void printPlacement(randomx_vm *vm, const uint8_t *scratchpad, size_t id, uint32_t node);
+
+    static inline RxConfig::JitMode jitMode()                { return m_jitMode; }
+    static inline void setJitMode(RxConfig::JitMode mode)    { m_jitMode = mode; }
+
+private:
+    static RxConfig::JitMode m_jitMode;
 };
 
 
@@ -0,0 +1,216 @@
+/* XMRig
+ * Copyright (c) 2018-2023 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2023 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "net/JobLatency.h"
+#include "3rdparty/rapidjson/document.h"
+#include "base/io/log/Log.h"
+#include "base/io/log/Tags.h"
+#include "base/net/stratum/Job.h"
+#include "base/tools/Chrono.h"
+
+
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+
+namespace xmrig {
+
+
+static constexpr size_t kSamples        = 256;
+static constexpr uint64_t kCompleteTime = 1000000;
+static const char *kStageNames[]        = { "parse", "dispatch", "ready", "first", "all", "total" };
+
+
+class JobLatencyPrivate
+{
+public:
+    struct Percentiles
+    {
+        bool valid      = false;
+        uint64_t p50    = 0;
+        uint64_t p99    = 0;
+        uint64_t max    = 0;
+    };
+
+    inline JobLatencyPrivate()
+    {
+        for (auto &samples : m_samples) {
+            samples.reserve(kSamples);
+        }
+    }
+
+    void started(const Job &job, uint64_t now)
+    {
+        const uint64_t ready = job.trace(Job::TRACE_READY);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (ready == m_trace[Job::TRACE_READY]) {
+            if (m_open) {
+                m_last = std::max(m_last, now);
+            }
+
+            return;
+        }
+
+        complete();
+
+        for (size_t i = 0; i < Job::TRACE_MAX; ++i) {
+            m_trace[i] = job.trace(static_cast<Job::TraceStage>(i));
+        }
+
+        m_first = now;
+        m_last  = now;
+        m_open  = true;
+    }
+
+    size_t printed = 0;
+
+    size_t snapshot(Percentiles *out, uint64_t now)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (m_open && now - m_trace[Job::TRACE_READY] > kCompleteTime) {
+            complete();
+        }
+
+        for (size_t i = 0; i < JobLatency::STAGE_MAX; ++i) {
+            std::vector<uint64_t> samples = m_samples[i];
+            if (samples.empty()) {
+                continue;
+            }
+
+            std::sort(samples.begin(), samples.end());
+
+            out[i].valid = true;
+            out[i].p50   = samples[(samples.size() - 1) * 50 / 100];
+            out[i].p99   = samples[(samples.size() - 1) * 99 / 100];
+            out[i].max   = samples.back();
+        }
+
+        return m_count;
+    }
+
+private:
+    inline uint64_t trace(Job::TraceStage stage) const { return m_trace[stage]; }
+
+    void add(JobLatency::Stage stage, uint64_t from, uint64_t to)
+    {
+        if (!from || to < from) {
+            return;
+        }
+
+        auto &samples = m_samples[stage];
+        if (samples.size() < kSamples) {
+            samples.push_back(to - from);
+        }
+        else {
+            samples[m_pos[stage]++ % kSamples] = to - from;
+        }
+    }
+
+    void complete()
+    {
+        if (!m_open) {
+            return;
+        }
+
+        add(JobLatency::PARSE,    trace(Job::TRACE_RECEIVED),   trace(Job::TRACE_PARSED));
+        add(JobLatency::DISPATCH, trace(Job::TRACE_PARSED),     trace(Job::TRACE_DISPATCHED));
+        add(JobLatency::READY,    trace(Job::TRACE_DISPATCHED), trace(Job::TRACE_READY));
+        add(JobLatency::FIRST,    trace(Job::TRACE_READY),      m_first);
+        add(JobLatency::ALL,      trace(Job::TRACE_READY),      m_last);
+        add(JobLatency::TOTAL,    trace(Job::TRACE_RECEIVED),   m_last);
+
+        m_open = false;
+        m_count++;
+    }
+
+    bool m_open         = false;
+    size_t m_count      = 0;
+    size_t m_pos[JobLatency::STAGE_MAX]{};
+    std::mutex m_mutex;
+    std::vector<uint64_t> m_samples[JobLatency::STAGE_MAX];
+    uint64_t m_first    = 0;
+    uint64_t m_last     = 0;
+    uint64_t m_trace[Job::TRACE_MAX]{};
+};
+
+
+static JobLatencyPrivate latency;
+
+
+} // namespace xmrig
+
+
+rapidjson::Value xmrig::JobLatency::toJSON(rapidjson::Document &doc)
+{
+    using namespace rapidjson;
+    auto &allocator = doc.GetAllocator();
+
+    JobLatencyPrivate::Percentiles stages[STAGE_MAX];
+    const size_t count = latency.snapshot(stages, Chrono::steadyUSecs());
+
+    Value out(kObjectType);
+    out.AddMember("jobs", static_cast<uint64_t>(count), allocator);
+
+    for (size_t i = 0; i < STAGE_MAX; ++i) {
+        Value stage(kArrayType);
+
+        if (stages[i].valid) {
+            stage.PushBack(stages[i].p50, allocator);
+            stage.PushBack(stages[i].p99, allocator);
+            stage.PushBack(stages[i].max, allocator);
+        }
+
+        out.AddMember(StringRef(kStageNames[i]), stage, allocator);
+    }
+
+    return out;
+}
+
+
+void xmrig::JobLatency::print()
+{
+    JobLatencyPrivate::Percentiles stages[STAGE_MAX];
+    const size_t count = latency.snapshot(stages, Chrono::steadyUSecs());
+    if (count == latency.printed || !stages[ALL].valid) {
+        return;
+    }
+
+    latency.printed = count;
+
+    auto ms = [](uint64_t us) { return static_cast<double>(us) / 1000.0; };
+    const auto &total = stages[TOTAL].valid ? stages[TOTAL] : stages[ALL];
+
+    LOG_INFO("%s " WHITE_BOLD("job latency") " p50/p99/max " CYAN_BOLD("%.3f/%.3f/%.3f ms") " p99 parse " WHITE_BOLD("%.3f") " dispatch " WHITE_BOLD("%.3f") " ready " WHITE_BOLD("%.3f") " first " WHITE_BOLD("%.3f") " all " WHITE_BOLD("%.3f"),
+             Tags::miner(),
+             ms(total.p50), ms(total.p99), ms(total.max),
+             ms(stages[PARSE].p99), ms(stages[DISPATCH].p99), ms(stages[READY].p99), ms(stages[FIRST].p99), ms(stages[ALL].p99)
+             );
+}
+
+
+void xmrig::JobLatency::started(const Job &job)
+{
+    if (job.trace(Job::TRACE_READY)) {
+        latency.started(job, Chrono::steadyUSecs());
+    }
+}
@@ -0,0 +1,60 @@
+/* XMRig
+ * Copyright (c) 2018-2023 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2023 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_JOBLATENCY_H
+#define XMRIG_JOBLATENCY_H
+
+
+#include "3rdparty/rapidjson/fwd.h"
+
+
+#include <cstdint>
+
+
+namespace xmrig {
+
+
+class Job;
+
+
+// Latency of new jobs from the pool socket to the workers, built from the Job::TraceStage timestamps and the moment every
+// worker starts hashing a job. Percentiles are taken over the last jobs, a job is complete once a newer job is started
+// or a second after it was published to the workers.
+class JobLatency
+{
+public:
+    enum Stage {
+        PARSE,      // socket read -> parsed by the client
+        DISPATCH,   // parsed -> handed over to the miner (strategy, network)
+        READY,      // handed over -> published to the workers
+        FIRST,      // published -> first worker hashing
+        ALL,        // published -> last worker hashing
+        TOTAL,      // socket read -> last worker hashing
+        STAGE_MAX
+    };
+
+    static rapidjson::Value toJSON(rapidjson::Document &doc);
+    static void print();
+    static void started(const Job &job);
+};
+
+
+} // namespace xmrig
+
+
+#endif /* XMRIG_JOBLATENCY_H */
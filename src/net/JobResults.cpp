@@ -60,6 +60,7 @@
 #include <memory>
 #include <mutex>
 #include <uv.h>
+#include <vector>
 
 
 namespace xmrig {
@@ -130,12 +131,28 @@ static void getResults(JobBundle &bundle, std::vector<JobResult> &results, uint3
 
         auto vm = RxVm::create(dataset, memory->scratchpad(), !hwAES, Assembly::NONE, 0);
 
-        for (uint32_t nonce : bundle.nonces) {
-            *bundle.job.nonce() = nonce;
+        // All nonces of a bundle are hashed in one batch, their Blake2b seeds and final hashes are computed together
+        const size_t size   = bundle.job.size();
+        const size_t count  = bundle.nonces.size();
+        std::vector<uint8_t> blobs(count * size);
+        std::vector<uint8_t> hashes(count * sizeof(hash));
+        std::vector<const void *> in(count);
+        std::vector<void *> out(count);
 
-            randomx_calculate_hash(vm, bundle.job.blob(), bundle.job.size(), hash);
+        for (size_t i = 0; i < count; ++i) {
+            *bundle.job.nonce() = bundle.nonces[i];
+            memcpy(blobs.data() + i * size, bundle.job.blob(), size);
 
-            checkHash(bundle, results, nonce, hash, errors);
+            in[i]  = blobs.data() + i * size;
+            out[i] = hashes.data() + i * sizeof(hash);
+        }
+
+        randomx_calculate_hash_batch(vm, in.data(), size, out.data(), count);
+
+        for (size_t i = 0; i < count; ++i) {
+            memcpy(hash, out[i], sizeof(hash));
+
+            checkHash(bundle, results, bundle.nonces[i], hash, errors);
         }
 
         RxVm::destroy(vm);
@@ -156,13 +173,15 @@ static void getResults(JobBundle &bundle, std::vector<JobResult> &results, uint3
 
             uint32_t output[8];
             uint32_t mix_hash[8];
-            {
-                std::lock_guard<std::mutex> lock(KPCache::s_cacheMutex);
 
-                KPCache::s_cache.init(bundle.job.height() / KPHash::EPOCH_LENGTH);
-                KPHash::calculate(KPCache::s_cache, bundle.job.height(), header_hash, full_nonce, output, mix_hash);
+            const auto cache = KPCache::get(bundle.job.height() / KPHash::EPOCH_LENGTH);
+            if (!cache) {
+                ++errors;
+                continue;
             }
 
+            KPHash::calculate(*cache, bundle.job.height(), header_hash, full_nonce, output, mix_hash);
+
             for (size_t i = 0; i < sizeof(hash); ++i) {
                 hash[i] = ((uint8_t*)output)[sizeof(hash) - 1 - i];
             }
@@ -188,6 +207,8 @@ static void getResults(JobBundle &bundle, std::vector<JobResult> &results, uint3
 
             checkHash(bundle, results, nonce, hash, errors);
         }
+
+        CnCtx::release(ctx, 1);
     }
 
     delete memory;
@@ -26,6 +26,7 @@
 #include "backend/common/Tags.h"
 #include "base/io/log/Log.h"
 #include "base/io/log/Tags.h"
+#include "base/net/dns/Dns.h"
 #include "base/net/stratum/Client.h"
 #include "base/net/stratum/NetworkState.h"
 #include "base/net/stratum/SubmitResult.h"
@@ -50,6 +51,11 @@
 #endif
 
 
+#ifdef XMRIG_ALGO_KAWPOW
+#   include "crypto/kawpow/KPCache.h"
+#endif
+
+
 #include <algorithm>
 #include <cinttypes>
 #include <ctime>
@@ -61,6 +67,11 @@ xmrig::Network::Network(Controller *controller) :
     m_controller(controller)
 {
     JobResults::setListener(this, controller->config()->cpu().isHwAES());
+
+#   ifdef XMRIG_ALGO_KAWPOW
+    KPCache::setFullDAG(controller->config()->cpu().isKawPowDAG());
+#   endif
+
     controller->addListener(this);
 
 #   ifdef XMRIG_FEATURE_API
@@ -93,6 +104,14 @@ xmrig::Network::~Network()
 
 void xmrig::Network::connect()
 {
+    if (Dns::config().isPreresolve()) {
+        for (const Pool &pool : m_controller->config()->pools().data()) {
+            if (pool.isEnabled()) {
+                Dns::preresolve(pool.proxy().isValid() ? pool.proxy().host() : pool.host());
+            }
+        }
+    }
+
     m_strategy->connect();
 }
 
@@ -149,6 +168,10 @@ void xmrig::Network::onActive(IStrategy *strategy, IClient *client)
 
 void xmrig::Network::onConfigChanged(Config *config, Config *previousConfig)
 {
+#   ifdef XMRIG_ALGO_KAWPOW
+    KPCache::setFullDAG(config->cpu().isKawPowDAG());
+#   endif
+
     if (config->pools() == previousConfig->pools() || !config->pools().active()) {
         return;
     }
@@ -323,6 +346,7 @@ void xmrig::Network::getConnection(rapidjson::Value &reply, rapidjson::Document
 
     reply.AddMember("algo",         m_state->algorithm().toJSON(), allocator);
     reply.AddMember("connection",   m_state->getConnection(doc, version), allocator);
+    reply.AddMember("dns",          Dns::toJSON(doc), allocator);
 }
 
 